@@ -53,6 +53,16 @@ CAbc1o3d::CAbc1o3d(CSpaceEH3d *s)
   abcCoef = (temp - 1.0) / (temp + 1.0);
 }
 
+CAbc1o3d::~CAbc1o3d()
+{
+  delete[] prevX0y; delete[] prevX0z;
+  delete[] prevX1y; delete[] prevX1z;
+  delete[] prevY0x; delete[] prevY0z;
+  delete[] prevY1x; delete[] prevY1z;
+  delete[] prevZ0x; delete[] prevZ0y;
+  delete[] prevZ1x; delete[] prevZ1y;
+}
+
 void CAbc1o3d::reset()
 {
   for(size_t i = 0; i < sy * sz; i++) {
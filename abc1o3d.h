@@ -32,6 +32,7 @@ class CAbc1o3d
 {
 public:
   CAbc1o3d(CSpaceEH3d *s);
+  ~CAbc1o3d();
 
   void reset();
   void update_e();
@@ -47,6 +47,17 @@ CAbc2o2d::CAbc2o2d(CSpaceEH2d *s)
   coef[2] = 4.0 * (temp1 + 1.0 / temp1) / temp2;
 }
 
+CAbc2o2d::~CAbc2o2d()
+{
+  for (int j = 0; j < 2; j++)
+    for (int i = 0; i < 3; i++) {
+      delete[] prevL[i][j];
+      delete[] prevR[i][j];
+      delete[] prevT[i][j];
+      delete[] prevB[i][j];
+    }
+}
+
 void CAbc2o2d::reset()
 {
   for (unsigned int j = 0; j < 2; j++) // time: back
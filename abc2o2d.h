@@ -30,6 +30,7 @@ class CAbc2o2d
 {
 public:
   CAbc2o2d(CSpaceEH2d *s);
+  ~CAbc2o2d();
   void reset();
   void update();
 private:
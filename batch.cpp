@@ -0,0 +1,296 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QRunnable>
+#include <math.h>
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "defs.h"
+#include "source.h"
+#include "shape.h"
+#include "voxelizer.h"
+#include "geometry3d.h"
+#include "utils.h"
+#include "batch.h"
+
+// NOTES:
+//  1) materials are e-field only (non-magnetic), h-fields use free-space
+//  2) the space boundary e-fields are not updated (pec walls)
+//  3) a run larger than the whole budget still runs, but alone; a run that
+//     can't allocate its fields fails alone (reported & its file marked)
+//  4) a sweep file has one run per line: source width (time steps) & sphere
+//     epsr (0: pec), blank lines & # comments skipped; the geometry, source,
+//     probe & steps are fixed by the batch definition
+
+CBatchParams::CBatchParams()
+{
+  gaussian = false;
+  scale = 10.0;
+  wts = 20.0;
+  src = probe = 0;
+  steps = 100;
+}
+
+// ***********************************************************************
+// memory budget: runs wait until their fields fit
+// ***********************************************************************
+class CBudget
+{
+public:
+  CBudget(size_t b) {free = b; total = b; done = 0;}
+  size_t acquire(size_t n) {
+    QMutexLocker lock(&mutex);
+    if(n > total) n = total; // too big: wait for the whole budget
+    while(n > free) released.wait(&mutex);
+    free -= n;
+    return n;
+  }
+  void release(size_t n, bool ok) {
+    QMutexLocker lock(&mutex);
+    free += n;
+    if(ok) done++;
+    released.wakeAll();
+  }
+  size_t done;
+private:
+  QMutex mutex;
+  QWaitCondition released;
+  size_t free, total;
+};
+
+// ***********************************************************************
+// one run: SoA fields & coefficient table over the shared geometry
+// ***********************************************************************
+class CBatchRun : public QRunnable
+{
+public:
+  CBatchRun(const CGeometry3d *g, const CBatchParams &p, CBudget *b, size_t bytes)
+    : g(g), p(p), budget(b), bytes(bytes) {}
+  void run();
+private:
+  const CGeometry3d *g;
+  CBatchParams p;
+  CBudget *budget;
+  size_t bytes;
+  double cee[256], ceh[256]; // e-field coefficients by material index
+  double *ex, *ey, *ez, *hx, *hy, *hz;
+  void update_e();
+  void update_h();
+};
+
+void CBatchRun::run()
+{
+  size_t held = budget->acquire(bytes);
+  for(size_t i = 0; i < 256; i++) { // free-space unless set
+    cee[i] = 1.0;
+    ceh[i] = DTDS3D * IMP0;
+  }
+  for(size_t i = 0; (i < p.materials.size()) && (i < 256); i++) {
+    const CMaterial &m = p.materials[i];
+    if(m.pec) cee[i] = ceh[i] = 0.0;
+    else {
+      cee[i] = (1.0 - m.loss) / (1.0 + m.loss);
+      ceh[i] = DTDS3D * IMP0 / (m.epsr * (1.0 + m.loss));
+    }
+  }
+
+  double **f[6] = {&ex, &ey, &ez, &hx, &hy, &hz};
+  bool allocated = true;
+  for(int a = 0; a < 6; a++) { // zeroed (large: fresh zero pages, touched on first update)
+    *f[a] = (double *)calloc(g->sXYZ, sizeof(double));
+    if(*f[a] == NULL) allocated = false;
+  }
+  if(!allocated) { // reported & marked, the other runs go on (no GUI here)
+    std::string m;
+    for(size_t i = 1; i < p.materials.size(); i++) {
+      char d[32];
+      if(p.materials[i].pec) sprintf(d, " pec");
+      else sprintf(d, " epsr %g", p.materials[i].epsr);
+      m += d;
+    }
+    printf("%s batch: %s out of memory (wts %g,%s)\n", TITLE, p.file.c_str(), p.wts, m.c_str());
+    std::ofstream out(p.file.c_str());
+    out << "# failed: out of memory\n";
+    for(int a = 0; a < 6; a++) free(*f[a]);
+    budget->release(held, false);
+    return;
+  }
+
+  std::ofstream out(p.file.c_str());
+  out.precision(12);
+  for(size_t t = 0; t < p.steps; t++) {
+    update_h();
+    update_e();
+    if(p.gaussian) sourceGaussian(true, p.scale, &ez[p.src], t, 4.0 * p.wts, -p.wts * p.wts);
+    else sourceRicker(true, p.scale, &ez[p.src], t, p.wts);
+    out << t << " " << ez[p.probe] << "\n";
+  }
+  bool ok = bool(out);
+  out.close();
+
+  for(int a = 0; a < 6; a++) free(*f[a]);
+  budget->release(held, ok);
+}
+
+void CBatchRun::update_e()
+{
+  size_t sX = g->sX;
+  size_t sXY = g->sXY;
+  for (size_t k = 1; k < g->sZ - 1; k++) { // don't update boundary e-fields
+    for (size_t j = 1; j < g->sY - 1; j++) {
+      for (size_t i = 1; i < sX - 1; i++) {
+        size_t n = i + j * sX + k * sXY;
+        unsigned char mx = g->mx[n];
+        unsigned char my = g->my[n];
+        unsigned char mz = g->mz[n];
+        ex[n] = cee[mx] * ex[n] + ceh[mx] * ((hz[n] - hz[n - sX]) - (hy[n] - hy[n - sXY]));
+        ey[n] = cee[my] * ey[n] + ceh[my] * ((hx[n] - hx[n - sXY]) - (hz[n] - hz[n - 1]));
+        ez[n] = cee[mz] * ez[n] + ceh[mz] * ((hy[n] - hy[n - 1]) - (hx[n] - hx[n - sX]));
+      }
+    }
+  }
+}
+
+void CBatchRun::update_h()
+{
+  size_t sX = g->sX;
+  size_t sXY = g->sXY;
+  double che = DTDS3D / IMP0;
+  for (size_t k = 0; k < g->sZ - 1; k++) {  // don't update highest h-fields
+    for (size_t j = 0; j < g->sY - 1; j++) {
+      for (size_t i = 0; i < sX - 1; i++) {
+        size_t n = i + j * sX + k * sXY;
+        hx[n] += che * ((ey[n + sXY] - ey[n]) - (ez[n + sX] - ez[n]));
+        hy[n] += che * ((ez[n + 1] - ez[n]) - (ex[n + sXY] - ex[n]));
+        hz[n] += che * ((ex[n + sX] - ex[n]) - (ey[n + 1] - ey[n]));
+      }
+    }
+  }
+}
+
+// ***********************************************************************
+// batch
+// ***********************************************************************
+CBatch::CBatch(const CGeometry3d *g, size_t budget)
+{
+  this->g = g;
+  this->budget = budget;
+}
+
+void CBatch::add(const CBatchParams &p)
+{
+  runs.push_back(p);
+}
+
+size_t CBatch::memory() const
+{
+  return 6 * g->sXYZ * sizeof(double);
+}
+
+size_t CBatch::run(int threads)
+{
+  CBudget b(budget);
+  QThreadPool pool;
+  if(threads > 0) pool.setMaxThreadCount(threads);
+  for(size_t i = 0; i < runs.size(); i++) pool.start(new CBatchRun(g, runs[i], &b, memory()));
+  pool.waitForDone();
+  return b.done;
+}
+
+// ***********************************************************************
+// batch definition: geometry built once, then swept
+// ***********************************************************************
+#define SIZEX 61
+#define SIZEY 61
+#define SIZEZ 61
+#define BUDGET (1024 * 1024 * 1024) // field memory (bytes)
+#define STEPS 400
+
+static bool read_sweep(const char *file, std::vector<double> &wts, std::vector<double> &epsr)
+{
+  std::ifstream in(file);
+  if(!in) return false;
+  std::string line;
+  while(std::getline(in, line)) {
+    std::istringstream ls(line.substr(0, line.find('#')));
+    double w, e;
+    if(!(ls >> w)) continue; // blank
+    if(!(ls >> e) || (w <= 0.0) || (e < 0.0)) return false;
+    wts.push_back(w);
+    epsr.push_back(e);
+  }
+  return !wts.empty();
+}
+
+// -batch [sweep file] (default: source widths 20, 40 & 80 x epsr 2, 4, 8 & pec)
+int batchMain(int argc, char *argv[])
+{
+  std::vector<double> wts, epsr; // per run: source width & sphere permittivity (0: pec)
+  if(argc > 2) {
+    if(!read_sweep(argv[2], wts, epsr)) {
+      printf("%s batch: can't read the sweep %s (lines: source width, epsr)\n", TITLE, argv[2]);
+      return 2;
+    }
+  }
+  else {
+    double w[] = {20.0, 40.0, 80.0};
+    double e[] = {2.0, 4.0, 8.0, 0.0};
+    for(size_t i = 0; i < sizeof(w) / sizeof(w[0]); i++) {
+      for(size_t j = 0; j < sizeof(e) / sizeof(e[0]); j++) {
+        wts.push_back(w[i]);
+        epsr.push_back(e[j]);
+      }
+    }
+  }
+
+  CGeometry3d g(SIZEX, SIZEY, SIZEZ);
+  CVoxelizer voxelizer;
+  CSphere sphere(3.0 * SIZEX / 4.0, SIZEY / 2.0, SIZEZ / 2.0, SIZEX / 7.0);
+  voxelizer.fill(&g, &sphere, 1); // material 1: the sphere
+
+  CBatch batch(&g, BUDGET);
+  size_t n = 0;
+  for(size_t r = 0; r < wts.size(); r++) {
+    CBatchParams p;
+    p.wts = wts[r];
+    p.steps = STEPS;
+    p.src = SIZEX / 4 + (SIZEY / 2) * SIZEX + (SIZEZ / 2) * SIZEX * SIZEY;
+    p.probe = SIZEX / 2 + (SIZEY / 2) * SIZEX + (SIZEZ / 2) * SIZEX * SIZEY;
+    p.materials.push_back(CMaterial());   // background: free-space
+    p.materials.push_back((epsr[r] > 0.0) ? CMaterial(epsr[r]) : CMaterial(1.0, 0.0, true));
+    char file[32];
+    sprintf(file, "batch_%03d.txt", int(n++));
+    p.file = file;
+    batch.add(p);
+  }
+  size_t done = batch.run();
+  printf("%s batch: %d of %d runs, %dx%dx%d, %.1f MB per run\n", TITLE, int(done), int(n),
+         SIZEX, SIZEY, SIZEZ, batch.memory() / (1024.0 * 1024.0));
+  return (done == n) ? 0 : 1;
+}
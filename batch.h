@@ -0,0 +1,68 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "voxelizer.h"
+
+class CGeometry3d;
+
+// one batch run: source, probe & materials (indexed by the geometry)
+class CBatchParams
+{
+public:
+  CBatchParams();
+  bool gaussian;       // gaussian (or ricker) point source
+  double scale;        // source amplitude
+  double wts;          // source width (time steps)
+  size_t src, probe;   // ez source & probe cells
+  size_t steps;        // time steps
+  std::vector<CMaterial> materials; // by material index (0: background)
+  std::string file;    // probe output
+};
+
+// parameter sweep runner
+// the geometry is shared read-only, each run keeps only its own fields (SoA)
+// & a small coefficient table, runs are packed onto a thread pool & started
+// only while their fields fit in the memory budget
+class CBatch
+{
+public:
+  CBatch(const CGeometry3d *g, size_t budget);
+  void add(const CBatchParams &p);
+  size_t run(int threads = 0); // completed runs (threads 0: one per core)
+  size_t memory() const;       // field bytes per run
+private:
+  const CGeometry3d *g;
+  size_t budget;
+  std::vector<CBatchParams> runs;
+};
+
+int batchMain(int argc, char *argv[]); // the batch definition (-batch [sweep file])
+
+#endif // BATCH_H
@@ -0,0 +1,454 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QString>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <vector>
+
+#include "defs.h"
+#include "cell1d.h"
+#include "cell2d.h"
+#include "cell3d.h"
+#include "spaceEH1d.h"
+#include "spaceEH2d.h"
+#include "spaceEH3d.h"
+#include "abc1o3d.h"
+#include "abc2o2d.h"
+#include "tfsf2d.h"
+#include "tfsf3d.h"
+#include "model2d.h"
+#include "model3d.h"
+#include "bench.h"
+#include "profiler.h"
+
+// NOTES:
+//  1) threads run independent copies of a case (the kernels are serial), so
+//     thread scaling shows when the copies saturate the shared caches & DRAM;
+//     each phase starts one job per thread on a pool of exactly that many
+//     threads (a copy may change thread between phases: first touch is only
+//     a hint on NUMA machines)
+//  2) GB/s assumes one pass over every cell record per call (bulk kernels
+//     only), a lower bound on the real traffic; the boundary kernels (abc,
+//     tfsf) report cell updates of the whole space they serve
+//  3) full steps use the compiled 2D & 3D models (their size, one thread)
+//  4) the solver is double precision only, the precision column is for
+//     comparing later modes
+//  5) fields start at zero (no denormals), materials are free-space
+//  6) the one thread flops_peak & stream_triad are saved as the profiler's
+//     roofs (ROOF_FILE), read by later runs from the same directory
+
+#define BENCH_UPDATES 50000000.0 // cell updates per case (sets the repetitions)
+#define BENCH_MIN_REPS 3
+#define BENCH_BUDGET (1024.0 * 1024.0 * 1024.0) // most case bytes (all threads)
+#define BENCH_BOUNDARY_MIN 16 // smallest edge for abc & tfsf cases
+#define STREAM_SIZE (1 << 23) // triad doubles per array (64 MB)
+#define STREAM_REPS 10
+#define PEAK_CHAINS 16 // independent multiply-add chains (latency hidden)
+#define PEAK_LOOPS 10000000
+
+enum {K_E1, K_H1, K_E2, K_H2, K_E3, K_H3, K_ABC1O3D, K_ABC2O2D, K_TFSF2D, K_TFSF3D,
+      K_STEP2D, K_STEP3D, KERNELS};
+
+static const struct {const char *name; int dim; bool bulk;} kernels[KERNELS] = {
+  {"spaceEH1d_e", 1, true}, {"spaceEH1d_h", 1, true},
+  {"spaceEH2d_e", 2, true}, {"spaceEH2d_h", 2, true},
+  {"spaceEH3d_e", 3, true}, {"spaceEH3d_h", 3, true},
+  {"abc1o3d", 3, false}, {"abc2o2d", 2, false},
+  {"tfsf2d", 2, false}, {"tfsf3d", 3, false},
+  {"model2d_step", 2, true}, {"model3d_step", 3, true}
+};
+
+// edges: L1, L2, L3 & DRAM resident (48, 72 & 144 byte cells)
+static const size_t edges[4][4] = {
+  {0, 0, 0, 0},
+  {512, 16384, 262144, 4194304},
+  {20, 128, 640, 1448},
+  {6, 20, 56, 112}
+};
+
+// ***********************************************************************
+// one thread's case: free-space fields & the kernel's boundary objects
+// ***********************************************************************
+class CBenchCase
+{
+public:
+  CBenchCase(int k, size_t edge);
+  ~CBenchCase();
+  void run(size_t reps);
+  size_t cells, bytes; // cells & bytes per cell
+
+private:
+  int kernel;
+  CSpaceEH1d *s1;
+  CSpaceEH2d *s2;
+  CSpaceEH3d *s3;
+  CAbc1o3d *abc3;
+  CAbc2o2d *abc2;
+  CTfsf2d *tfsf2;
+  CTfsf3d *tfsf3;
+};
+
+CBenchCase::CBenchCase(int k, size_t edge)
+{
+  kernel = k;
+  s1 = NULL; s2 = NULL; s3 = NULL;
+  abc3 = NULL; abc2 = NULL;
+  tfsf2 = NULL; tfsf3 = NULL;
+  if(kernels[k].dim == 1) {
+    s1 = new CSpaceEH1d(edge);
+    for(size_t i = 0; i < edge; i++) {
+      s1->c[i].cee = 1.0;
+      s1->c[i].ceh = IMP0;
+      s1->c[i].chh = 1.0;
+      s1->c[i].che = 1.0 / IMP0;
+    }
+    s1->reset();
+    cells = edge;
+    bytes = sizeof(Ccell1d);
+  }
+  else if(kernels[k].dim == 2) {
+    s2 = new CSpaceEH2d(edge, edge);
+    for(size_t n = 0; n < s2->sXY; n++) {
+      s2->c[n].cee = 1.0;
+      s2->c[n].ceh = DTDS2D * IMP0;
+      s2->c[n].ch1h = s2->c[n].ch2h = 1.0;
+      s2->c[n].ch1e = s2->c[n].ch2e = DTDS2D / IMP0;
+    }
+    s2->reset();
+    if(k == K_ABC2O2D) abc2 = new CAbc2o2d(s2);
+    if(k == K_TFSF2D) tfsf2 = new CTfsf2d(s2, 3, 10);
+    cells = s2->sXY;
+    bytes = sizeof(Ccell2d);
+  }
+  else {
+    s3 = new CSpaceEH3d(edge, edge, edge);
+    for(size_t n = 0; n < s3->sXYZ; n++) {
+      s3->c[n].cexe = s3->c[n].ceye = s3->c[n].ceze = 1.0;
+      s3->c[n].cexh = s3->c[n].ceyh = s3->c[n].cezh = DTDS3D * IMP0;
+      s3->c[n].chxh = s3->c[n].chyh = s3->c[n].chzh = 1.0;
+      s3->c[n].chxe = s3->c[n].chye = s3->c[n].chze = DTDS3D / IMP0;
+    }
+    s3->reset();
+    if(k == K_ABC1O3D) abc3 = new CAbc1o3d(s3);
+    if(k == K_TFSF3D) tfsf3 = new CTfsf3d(s3, 3, 10);
+    cells = s3->sXYZ;
+    bytes = sizeof(Ccell3d);
+  }
+}
+
+CBenchCase::~CBenchCase()
+{
+  delete abc3;
+  delete abc2;
+  delete tfsf2;
+  delete tfsf3;
+  delete s1;
+  delete s2;
+  delete s3;
+}
+
+void CBenchCase::run(size_t reps)
+{
+  for(size_t r = 0; r < reps; r++) {
+    switch(kernel) {
+    case K_E1: s1->update_e(); break;
+    case K_H1: s1->update_h(); break;
+    case K_E2: s2->update_e(); break;
+    case K_H2: s2->update_h(); break;
+    case K_E3: s3->update_e(); break;
+    case K_H3: s3->update_h(); break;
+    case K_ABC1O3D: abc3->update_e(); break;
+    case K_ABC2O2D: abc2->update(); break;
+    case K_TFSF2D: tfsf2->updateA(); tfsf2->updateB(); break;
+    case K_TFSF3D: tfsf3->updateA(); tfsf3->updateB(); break;
+    }
+  }
+}
+
+// ***********************************************************************
+// results
+// ***********************************************************************
+class CBenchResult
+{
+public:
+  const char *kernel;
+  int dim;
+  size_t edge, cells, reps;
+  int threads;
+  double ns;     // per call (one thread)
+  double mcells; // cell updates per second (all threads, millions)
+  double gbs;    // bulk kernels only (0.0: boundary)
+  double stream; // triad GB/s at this thread count
+};
+
+// one thread's share of a phase (a pool job)
+class CBenchJob : public QRunnable
+{
+public:
+  enum {TRIAD_INIT, TRIAD, CASE_NEW, CASE_RUN};
+  CBenchJob(int job) : job(job) {}
+  void run();
+  int job;
+  double *a, *b, *c; // triad arrays, [first, last)
+  long first, last;
+  CBenchCase **cs;   // case
+  int kernel;
+  size_t edge, reps;
+};
+
+void CBenchJob::run()
+{
+  if(job == TRIAD_INIT) {
+    for(long i = first; i < last; i++) {
+      a[i] = 0.0;
+      b[i] = 1.0;
+      c[i] = 2.0;
+    }
+  }
+  else if(job == TRIAD) {
+    double s = 3.0;
+    for(long i = first; i < last; i++) a[i] = b[i] + s * c[i];
+  }
+  else if(job == CASE_NEW) *cs = new CBenchCase(kernel, edge);
+  else (*cs)->run(reps);
+}
+
+static void triad_phase(QThreadPool &pool, int job, int threads, double *a, double *b, double *c)
+{
+  for(int t = 0; t < threads; t++) {
+    CBenchJob *j = new CBenchJob(job);
+    j->a = a; j->b = b; j->c = c;
+    j->first = long(STREAM_SIZE) * t / threads;
+    j->last = long(STREAM_SIZE) * (t + 1) / threads;
+    pool.start(j);
+  }
+  pool.waitForDone();
+}
+
+static double stream_triad(int threads) // best of STREAM_REPS (GB/s)
+{
+  std::vector<double> a(STREAM_SIZE), b(STREAM_SIZE), c(STREAM_SIZE);
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+  triad_phase(pool, CBenchJob::TRIAD_INIT, threads, &a[0], &b[0], &c[0]); // first touch
+  qint64 best = 0;
+  QElapsedTimer timer;
+  for(int r = 0; r < STREAM_REPS; r++) {
+    timer.start();
+    triad_phase(pool, CBenchJob::TRIAD, threads, &a[0], &b[0], &c[0]);
+    qint64 t = timer.nsecsElapsed();
+    if((r == 0) || (t < best)) best = t;
+  }
+  return 3.0 * sizeof(double) * STREAM_SIZE / best;
+}
+
+static double flops_peak() // one thread multiply-adds, best of STREAM_REPS (GFLOP/s)
+{
+  double x[PEAK_CHAINS];
+  for(int i = 0; i < PEAK_CHAINS; i++) x[i] = 1.0 + i / double(PEAK_CHAINS);
+  qint64 best = 0;
+  QElapsedTimer timer;
+  for(int r = 0; r < STREAM_REPS; r++) {
+    timer.start();
+    for(long n = 0; n < PEAK_LOOPS; n++)
+      for(int i = 0; i < PEAK_CHAINS; i++) x[i] = x[i] * 0.999999 + 0.000001;
+    qint64 t = timer.nsecsElapsed();
+    if((r == 0) || (t < best)) best = t;
+  }
+  volatile double sink = 0.0; // keep the chains
+  for(int i = 0; i < PEAK_CHAINS; i++) sink = sink + x[i];
+  return 2.0 * PEAK_CHAINS * PEAK_LOOPS / best;
+}
+
+static size_t reps_for(size_t cells)
+{
+  size_t reps = size_t(BENCH_UPDATES / cells);
+  return (reps < BENCH_MIN_REPS) ? BENCH_MIN_REPS : reps;
+}
+
+static void case_phase(QThreadPool &pool, int job, std::vector<CBenchCase *> &cases,
+                       int k, size_t edge, size_t reps)
+{
+  for(size_t t = 0; t < cases.size(); t++) {
+    CBenchJob *j = new CBenchJob(job);
+    j->cs = &cases[t];
+    j->kernel = k;
+    j->edge = edge;
+    j->reps = reps;
+    pool.start(j);
+  }
+  pool.waitForDone();
+}
+
+static void run_case(int k, size_t edge, int threads, double stream, CBenchResult *r)
+{
+  std::vector<CBenchCase *> cases(threads);
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+  case_phase(pool, CBenchJob::CASE_NEW, cases, k, edge, 0); // first touch
+  size_t reps = reps_for(kernels[k].bulk ? cases[0]->cells : cases[0]->cells / edge); // boundary: faces
+  case_phase(pool, CBenchJob::CASE_RUN, cases, k, edge, 1); // warm up
+  QElapsedTimer timer;
+  timer.start();
+  case_phase(pool, CBenchJob::CASE_RUN, cases, k, edge, reps);
+  double ns = timer.nsecsElapsed();
+
+  r->kernel = kernels[k].name;
+  r->dim = kernels[k].dim;
+  r->edge = edge;
+  r->cells = cases[0]->cells;
+  r->reps = reps;
+  r->threads = threads;
+  r->ns = ns / reps;
+  r->mcells = 1000.0 * threads * reps * r->cells / ns;
+  r->gbs = kernels[k].bulk ? r->mcells * cases[0]->bytes / 1000.0 : 0.0;
+  r->stream = stream;
+  for(int t = 0; t < threads; t++) delete cases[t];
+}
+
+static void run_model(int k, CModel *model, size_t cells, size_t bytes, double stream, CBenchResult *r)
+{
+  size_t reps = reps_for(cells);
+  model->step(); // warm up
+  QElapsedTimer timer;
+  timer.start();
+  for(size_t s = 0; s < reps; s++) model->step();
+  double ns = timer.nsecsElapsed();
+
+  r->kernel = kernels[k].name;
+  r->dim = kernels[k].dim;
+  r->edge = size_t(floor(pow(double(cells), 1.0 / r->dim) + 0.5));
+  r->cells = cells;
+  r->reps = reps;
+  r->threads = 1;
+  r->ns = ns / reps;
+  r->mcells = 1000.0 * reps * cells / ns;
+  r->gbs = r->mcells * bytes / 1000.0;
+  r->stream = stream;
+}
+
+static void print(const CBenchResult &r)
+{
+  printf("%-14s %dD %8d^%d %3d threads %12.0f ns %9.1f Mcells/s", r.kernel, r.dim,
+         int(r.edge), r.dim, r.threads, r.ns, r.mcells);
+  if(r.gbs > 0.0) printf(" %7.2f GB/s (%3.0f%% stream)", r.gbs, 100.0 * r.gbs / r.stream);
+  printf("\n");
+  fflush(stdout);
+}
+
+static bool write(const char *file, const char *label, const std::vector<CBenchResult> &results)
+{
+  std::ofstream out(file);
+  if(!out) return false;
+  bool json = QString(file).endsWith(".json");
+  if(json) out << "{\n  \"title\": \"" << TITLE << "\",\n  \"label\": \"" << label << "\",\n  \"results\": [\n";
+  else out << "label,kernel,dim,edge,cells,threads,precision,reps,ns_per_call,mcells_s,gb_s,stream_gb_s\n";
+  for(size_t i = 0; i < results.size(); i++) {
+    const CBenchResult &r = results[i];
+    if(json) {
+      out << "    {\"kernel\": \"" << r.kernel << "\", \"dim\": " << r.dim << ", \"edge\": " << r.edge
+          << ", \"cells\": " << r.cells << ", \"threads\": " << r.threads << ", \"precision\": \"double\""
+          << ", \"reps\": " << r.reps << ", \"ns_per_call\": " << r.ns << ", \"mcells_s\": " << r.mcells
+          << ", \"gb_s\": " << r.gbs << ", \"stream_gb_s\": " << r.stream << "}"
+          << ((i + 1 < results.size()) ? ",\n" : "\n");
+    }
+    else {
+      out << label << "," << r.kernel << "," << r.dim << "," << r.edge << "," << r.cells << ","
+          << r.threads << ",double," << r.reps << "," << r.ns << "," << r.mcells << ","
+          << r.gbs << "," << r.stream << "\n";
+    }
+  }
+  if(json) out << "  ]\n}\n";
+  return true;
+}
+
+// ***********************************************************************
+// -bench [file] [label]
+// ***********************************************************************
+int benchMain(int argc, char *argv[])
+{
+  const char *file = (argc > 2) ? argv[2] : "bench.csv";
+  const char *label = (argc > 3) ? argv[3] : "";
+  int max_threads = QThread::idealThreadCount();
+  if(max_threads < 1) max_threads = 1;
+  std::vector<int> threads;
+  for(int t = 1; t < max_threads; t *= 2) threads.push_back(t);
+  threads.push_back(max_threads);
+
+  std::vector<double> stream(threads.size());
+  for(size_t t = 0; t < threads.size(); t++) {
+    stream[t] = stream_triad(threads[t]);
+    printf("%-14s %3d threads %7.2f GB/s\n", "stream_triad", threads[t], stream[t]);
+  }
+  double peak = flops_peak();
+  printf("%-14s %3d threads %7.2f GFLOP/s\n", "flops_peak", 1, peak);
+  profiler.set_roof(peak, stream[0]);
+  if(!profiler.write_roof(ROOF_FILE)) printf("%s bench: can't write %s\n", TITLE, ROOF_FILE);
+
+  std::vector<CBenchResult> results;
+  CBenchResult r;
+  for(int k = 0; k < K_STEP2D; k++) {
+    for(int e = 0; e < 4; e++) {
+      size_t edge = edges[kernels[k].dim][e];
+      if(!kernels[k].bulk && (edge < BENCH_BOUNDARY_MIN)) continue;
+      CBenchCase probe(k, edge);
+      double bytes = double(probe.cells) * probe.bytes;
+      for(size_t t = 0; t < threads.size(); t++) {
+        if((t > 0) && (threads[t] * bytes > BENCH_BUDGET)) break;
+        run_case(k, edge, threads[t], stream[t], &r);
+        print(r);
+        results.push_back(r);
+      }
+    }
+  }
+
+  CModel2D *model2d = new CModel2D(NULL);
+  run_model(K_STEP2D, model2d, model2d->cells(), sizeof(Ccell2d), stream[0], &r);
+  print(r);
+  results.push_back(r);
+  delete model2d;
+  CModel3D *model3d = new CModel3D(NULL);
+  if(!model3d->error.isEmpty()) {
+    printf("%s bench: %s\n", TITLE, model3d->error.toStdString().c_str());
+    delete model3d;
+    return 1;
+  }
+  run_model(K_STEP3D, model3d, model3d->cells(), sizeof(Ccell3d), stream[0], &r);
+  print(r);
+  results.push_back(r);
+  delete model3d;
+
+  if(!write(file, label, results)) {
+    printf("%s bench: can't write %s\n", TITLE, file);
+    return 1;
+  }
+  printf("%s bench: %d cases to %s\n", TITLE, int(results.size()), file);
+  return 0;
+}
@@ -0,0 +1,34 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// solver kernel benchmarks (-bench [file] [label])
+// every kernel over grid sizes from L1 to DRAM resident & thread counts,
+// cell updates per second & GB/s against a measured STREAM triad bandwidth,
+// results to a CSV (or *.json) file, one row per case, tagged by the label
+// (e.g. the commit) so runs can be compared
+int benchMain(int argc, char *argv[]);
+
+#endif // BENCH_H
@@ -0,0 +1,65 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include "model.h"
+#include "model1d.h"
+#include "model2d.h"
+#include "model3d.h"
+#include "builder.h"
+
+// NOTES:
+//  1) model constructors only allocate and fill memory (spaces, materials,
+//     point clouds), their display lists are made later by init_gl()
+//  2) constructors never show a message (GUI calls belong to the GUI thread),
+//     a failure is left in the model's error for the GUI to report
+
+CBuilder::CBuilder(int d, GLWidget *parent)
+{
+  dim = d;
+  p = parent;
+  model = NULL;
+}
+
+CBuilder::~CBuilder()
+{
+  wait();
+  delete model;
+}
+
+CModel *CBuilder::take()
+{
+  wait();
+  CModel *m = model;
+  model = NULL;
+  return m;
+}
+
+void CBuilder::run()
+{
+  CModel::build_progress = 0;
+  switch(dim) {
+  case 1: model = new CModel1D(p); break;
+  case 2: model = new CModel2D(p); break;
+  case 3: model = new CModel3D(p); break;
+  }
+  CModel::build_progress = 100;
+}
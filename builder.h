@@ -0,0 +1,50 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef BUILDER_H
+#define BUILDER_H
+
+#include <QThread>
+
+class CModel;
+class GLWidget;
+
+// builds a model on its own thread, the GUI polls for it (CModel::build_progress)
+// no OpenGL here: the GUI thread calls init_gl() once the model is taken
+class CBuilder : public QThread
+{
+public:
+  CBuilder(int d, GLWidget *parent);
+  ~CBuilder(); // waits, an untaken model is deleted
+
+  int dim;         // model dimension (1, 2 or 3)
+  CModel *take();  // the built model (once finished)
+
+protected:
+  void run();
+
+private:
+  GLWidget *p;
+  CModel *model;
+};
+
+#endif // BUILDER_H
@@ -25,9 +25,3 @@ rugis@msu.edu
 Ccell2d::Ccell2d()
 {
 }
-
-void Ccell2d::reset()
-{
-  e = 0.0;  // electric field
-  h1 = h2 = 0.0; // magnetic field
-}
@@ -27,7 +27,11 @@ class Ccell2d
 {
 public:
   Ccell2d();
-  void reset();
+  void reset() // inline: zeroed in bulk by CSpaceEH2d::reset()
+  {
+    e = 0.0;  // electric field
+    h1 = h2 = 0.0; // magnetic field
+  }
 
   double e, h1, h2;     // electric & magnetic fields
   double cee, ceh; // space parameters
@@ -25,9 +25,3 @@ rugis@msu.edu
 Ccell3d::Ccell3d()
 {
 }
-
-void Ccell3d::reset()
-{
-  ex = ey = ez = 0.0;  // electric field
-  hx = hy = hz = 0.0; // magnetic field
-}
@@ -27,7 +27,11 @@ class Ccell3d
 {
 public:
   Ccell3d();
-  void reset();
+  void reset() // inline: zeroed in bulk by CSpaceEH3d::reset()
+  {
+    ex = ey = ez = 0.0;  // electric field
+    hx = hy = hz = 0.0; // magnetic field
+  }
 
   double ex, ey, ez, hx, hy, hz;     // electric & magnetic fields
   double cexe, cexh; // space parameters
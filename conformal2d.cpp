@@ -0,0 +1,85 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "cell2d.h"
+#include "spaceEH2d.h"
+#include "shape.h"
+#include "conformal2d.h"
+
+// NOTES:
+//  1) the 2D space lies in the z = 0 plane, use shapes extended along z
+//  2) face lengths are clamped at amin (small cells), the time-step factor
+//     dtf = sqrt(min(length)) then keeps the cut cells stable
+//  3) call reduce_dt() before any tfsf or abc is set (they copy coefficients)
+
+#define EPS 1.0e-6 // uncut length tolerance
+
+CConformal2d::CConformal2d(CSpaceEH2d *s, const CShape *shape, double amin)
+{
+  c = s->c;
+  sx = s->sX;
+  sy = s->sY;
+  dtf = 1.0;
+  cut = 0;
+
+  for (size_t j = 0; j < sy; j++) {
+    for (size_t i = 0; i < sx; i++) {
+      size_t n = i + j * sx;
+      double p[3] = {double(i), double(j), 0.0};
+      if(shape->inside(p)) c[n].cee = c[n].ceh = 0.0; // staircase pec
+    }
+  }
+
+  for (size_t j = 0; j < sy - 1; j++) { // h-field faces (lines in 2D)
+    for (size_t i = 0; i < sx - 1; i++) {
+      size_t n = i + j * sx;
+      double p[3] = {double(i), double(j), 0.0};
+      double l1 = shape->outside(1, p); // h1 (x-normal) face along y
+      double l2 = shape->outside(0, p); // h2 (y-normal) face along x
+      if((l1 > EPS) && (l1 < 1.0 - EPS)) {
+        if(l1 < amin) l1 = amin;
+        if(sqrt(l1) < dtf) dtf = sqrt(l1);
+        c[n].ch1e /= l1;
+        cut++;
+      }
+      if((l2 > EPS) && (l2 < 1.0 - EPS)) {
+        if(l2 < amin) l2 = amin;
+        if(sqrt(l2) < dtf) dtf = sqrt(l2);
+        c[n].ch2e /= l2;
+        cut++;
+      }
+    }
+  }
+}
+
+void CConformal2d::reduce_dt()
+{
+  for(size_t n = 0; n < sx * sy; n++) {
+    c[n].ceh *= dtf;
+    c[n].ch1e *= dtf;
+    c[n].ch2e *= dtf;
+  }
+}
@@ -0,0 +1,47 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef CONFORMAL2D_H
+#define CONFORMAL2D_H
+
+class Ccell2d;
+class CSpaceEH2d;
+class CShape;
+
+// conformal (Dey-Mittra) PEC object in a 2D (Ez Hx Hy) space
+// e-fields inside the object are zeroed (as staircasing), the h-field
+// coefficients of cut cell faces are scaled by the inverse face length
+// (no extra field update is needed)
+class CConformal2d
+{
+public:
+  CConformal2d(CSpaceEH2d *s, const CShape *shape, double amin);
+  void reduce_dt();    // scale space update coefficients by dtf
+  double dtf;          // stable time-step factor
+  size_t cut;          // number of cut faces
+private:
+  Ccell2d *c;          // the 2D model space
+  size_t sx, sy;       // size of 2D model space
+};
+
+#endif // CONFORMAL2D_H
@@ -0,0 +1,137 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+
+#include "cell3d.h"
+#include "spaceEH3d.h"
+#include "shape.h"
+#include "conformal3d.h"
+
+// NOTES:
+//  1) face area fractions are integrated over NS strips
+//  2) face areas are clamped at amin (small cells), the time-step factor
+//     dtf = sqrt(min(area / longest edge)) then keeps the cut cells stable
+//  3) call reduce_dt() before any tfsf or abc is set (they copy coefficients)
+
+#define NS 16      // area integration strips
+#define EPS 1.0e-6 // uncut length & area tolerance
+
+static double *e_field(Ccell3d *c, int a)
+{
+  if(a == 0) return &(c->ex);
+  if(a == 1) return &(c->ey);
+  return &(c->ez);
+}
+
+CConformal3d::CConformal3d(CSpaceEH3d *s, const CShape *shape, double amin)
+{
+  c = s->c;
+  sx = s->sX;
+  sy = s->sY;
+  sz = s->sZ;
+  sxy = s->sXY;
+  sxyz = s->sXYZ;
+  dtf = 1.0;
+  size_t off[3] = {1, sx, sxy};
+  double b0[3], b1[3];
+  shape->bounds(b0, b1);
+
+  for (size_t k = 0; k < sz; k++) {
+    for (size_t j = 0; j < sy; j++) {
+      for (size_t i = 0; i < sx; i++) {
+        size_t n = i + j * sx + k * sxy;
+        double p[3] = {double(i), double(j), double(k)};
+        if((p[0] + 1.0 < b0[0]) || (p[0] > b1[0]) || (p[1] + 1.0 < b0[1])
+          || (p[1] > b1[1]) || (p[2] + 1.0 < b0[2]) || (p[2] > b1[2])) continue; // culled
+
+        // edges fully inside: staircase pec
+        if(shape->outside(0, p) < EPS) c[n].cexe = c[n].cexh = 0.0;
+        if(shape->outside(1, p) < EPS) c[n].ceye = c[n].ceyh = 0.0;
+        if(shape->outside(2, p) < EPS) c[n].ceze = c[n].cezh = 0.0;
+
+        if((i == sx - 1) || (j == sy - 1) || (k == sz - 1)) continue; // not updated
+        for (int a = 0; a < 3; a++) { // h-field face normal
+          int u = (a + 1) % 3;
+          int v = (a + 2) % 3;
+          double pu[3] = {p[0], p[1], p[2]};
+          double pv[3] = {p[0], p[1], p[2]};
+          pu[u] += 1.0;
+          pv[v] += 1.0;
+          double l[4]; // contour edge lengths
+          l[0] = shape->outside(u, p);  // e_u at v
+          l[1] = shape->outside(u, pv); // e_u at v + 1
+          l[2] = shape->outside(v, p);  // e_v at u
+          l[3] = shape->outside(v, pu); // e_v at u + 1
+          double area = 0.0;
+          for (int q = 0; q < NS; q++) {
+            double ps[3] = {p[0], p[1], p[2]};
+            ps[v] += (q + 0.5) / NS;
+            area += shape->outside(u, ps);
+          }
+          area /= NS;
+          if((l[0] < EPS) && (l[1] < EPS) && (l[2] < EPS) && (l[3] < EPS)) continue; // inside
+          if((area > 1.0 - EPS) && (l[0] > 1.0 - EPS) && (l[1] > 1.0 - EPS)
+            && (l[2] > 1.0 - EPS) && (l[3] > 1.0 - EPS)) continue; // not cut
+
+          if(area < amin) area = amin;
+          double lmax = 0.0;
+          for (int q = 0; q < 4; q++) if(l[q] > lmax) lmax = l[q];
+          if(sqrt(area / lmax) < dtf) dtf = sqrt(area / lmax);
+
+          CCutFace f;
+          Ccell3d *cn = &(c[n]);
+          f.h = (a == 0) ? &(cn->hx) : ((a == 1) ? &(cn->hy) : &(cn->hz));
+          f.che = (a == 0) ? &(cn->chxe) : ((a == 1) ? &(cn->chye) : &(cn->chze));
+          f.e[0] = e_field(cn, u);
+          f.e[1] = e_field(&(c[n + off[v]]), u);
+          f.e[2] = e_field(cn, v);
+          f.e[3] = e_field(&(c[n + off[u]]), v);
+          f.w[0] = -(l[0] / area - 1.0);
+          f.w[1] = l[1] / area - 1.0;
+          f.w[2] = l[2] / area - 1.0;
+          f.w[3] = -(l[3] / area - 1.0);
+          faces.push_back(f);
+        }
+      }
+    }
+  }
+  cut = faces.size();
+}
+
+void CConformal3d::reduce_dt()
+{
+  for(size_t n = 0; n < sxyz; n++) {
+    c[n].cexh *= dtf; c[n].ceyh *= dtf; c[n].cezh *= dtf;
+    c[n].chxe *= dtf; c[n].chye *= dtf; c[n].chze *= dtf;
+  }
+}
+
+void CConformal3d::update_h()
+{
+  for(size_t m = 0; m < cut; m++) {
+    CCutFace &f = faces[m];
+    *f.h += *f.che *
+      (f.w[0] * *f.e[0] + f.w[1] * *f.e[1] + f.w[2] * *f.e[2] + f.w[3] * *f.e[3]);
+  }
+}
@@ -0,0 +1,59 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef CONFORMAL3D_H
+#define CONFORMAL3D_H
+
+#include <stdlib.h>
+#include <vector>
+
+class Ccell3d;
+class CSpaceEH3d;
+class CShape;
+
+// conformal (Dey-Mittra) PEC object in a 3D space
+// e-fields on edges fully inside the object are zeroed (as staircasing),
+// h-fields on cut cell faces are updated from the contour integral of the
+// partial edge lengths over the partial face area
+class CConformal3d
+{
+public:
+  CConformal3d(CSpaceEH3d *s, const CShape *shape, double amin);
+  void reduce_dt();    // scale space update coefficients by dtf
+  void update_h();     // after space h-field update
+  double dtf;          // stable time-step factor
+  size_t cut;          // number of cut faces
+private:
+  struct CCutFace {
+    double *h;         // h-field
+    const double *che; // h-field update coefficient
+    double *e[4];      // contour e-fields
+    double w[4];       // contour weights (additive to the regular update)
+  };
+  Ccell3d *c;          // the 3D model space
+  size_t sx, sy, sz;   // size of 3D model space
+  size_t sxy, sxyz;
+  std::vector<CCutFace> faces;
+};
+
+#endif // CONFORMAL3D_H
@@ -46,6 +46,10 @@ rugis@msu.edu
 
 #define TITLE "GL_10"
 #define USE_LEAP
+#define SOLVER_THREAD // model steps on its own thread, display from snapshots
+//#define PROFILE     // per phase step & draw timing (profiler.h, a lock per phase)
+#define SLICE_TEXTURE // 2D/3D planar cuts as a texture & heightfield (else, thinned or dithered: points)
+//#define PROFILE_COUNTERS // & hardware counters per step phase (with PROFILE, Linux perf_event)
 
 // ***********************************************************************
 // visual display constants
@@ -57,6 +61,7 @@ rugis@msu.edu
 // ***********************************************************************
 #define D22    // field update method
 //#define D24
+#define ENSEMBLE_LANES 8 // simulations per ensemble (SIMD lanes: 4, 8, 16)
 
 // ***********************************************************************
 // electrical constants
@@ -0,0 +1,157 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QElapsedTimer>
+#include <math.h>
+#include <stdio.h>
+
+#include "defs.h"
+#include "source.h"
+#include "cell1d.h"
+#include "cell2d.h"
+#include "spaceEH1d.h"
+#include "spaceEH2d.h"
+#include "abc2o1d.h"
+#include "ensemble1d.h"
+#include "ensemble2d.h"
+#include "ensemble.h"
+
+// NOTES:
+//  1) ENSEMBLE_LANES dielectric half-spaces (lane l: epsr 1 + l) run side by
+//     side & the same runs one by one on the scalar solvers (1D with the
+//     second order abc, 2D with pec walls), every lane must match its scalar
+//     run bit for bit
+//  2) the speedup is the scalar runs' time over the ensemble time
+
+#define ENSEMBLE_SIZE1D 1000
+#define ENSEMBLE_SIZE2D 101
+#define ENSEMBLE_STEPS 400
+#define ENSEMBLE_WTS 20.0
+
+static size_t ensemble1d(double *ts, double *te) // mismatched lanes
+{
+  size_t s = ENSEMBLE_SIZE1D;
+  size_t src = s / 4;
+  QElapsedTimer timer;
+  CEnsemble1d ens(s);
+  for(size_t l = 0; l < ENSEMBLE_LANES; l++)
+    for(size_t i = s / 2; i < s; i++) ens.ceh[ens.at(i, l)] = IMP0 / (1.0 + l);
+  ens.set_abc();
+  ens.reset();
+  timer.start();
+  for(size_t t = 0; t < ENSEMBLE_STEPS; t++) {
+    ens.update_h();
+    ens.update_e();
+    for(size_t l = 0; l < ENSEMBLE_LANES; l++) sourceRicker(true, 0.4, &ens.e[ens.at(src, l)], t, ENSEMBLE_WTS);
+  }
+  *te = timer.nsecsElapsed();
+
+  size_t bad = 0;
+  *ts = 0.0;
+  for(size_t l = 0; l < ENSEMBLE_LANES; l++) {
+    CSpaceEH1d space(s);
+    for(size_t i = 0; i < s; i++) {
+      space.c[i].cee = 1.0;
+      space.c[i].ceh = (i < s / 2) ? IMP0 : IMP0 / (1.0 + l);
+      space.c[i].chh = 1.0;
+      space.c[i].che = 1.0 / IMP0;
+    }
+    CAbc2o1d abc(&space);
+    space.reset();
+    abc.reset();
+    timer.start();
+    for(size_t t = 0; t < ENSEMBLE_STEPS; t++) {
+      space.update_h();
+      abc.update_h();
+      space.update_e();
+      abc.update_e();
+      sourceRicker(true, 0.4, &space.c[src].e, t, ENSEMBLE_WTS);
+    }
+    *ts += timer.nsecsElapsed();
+    for(size_t i = 0; i < s; i++) {
+      if((space.c[i].e != ens.e[ens.at(i, l)]) || (space.c[i].h != ens.h[ens.at(i, l)])) {
+        bad++;
+        break;
+      }
+    }
+  }
+  return bad;
+}
+
+static size_t ensemble2d(double *ts, double *te) // mismatched lanes
+{
+  size_t s = ENSEMBLE_SIZE2D;
+  size_t src = s / 4 + (s / 2) * s;
+  QElapsedTimer timer;
+  CEnsemble2d ens(s, s);
+  for(size_t l = 0; l < ENSEMBLE_LANES; l++)
+    for(size_t j = 0; j < s; j++)
+      for(size_t i = s / 2; i < s; i++) ens.ceh[ens.at(i, j, l)] = DTDS2D * IMP0 / (1.0 + l);
+  ens.reset();
+  timer.start();
+  for(size_t t = 0; t < ENSEMBLE_STEPS; t++) {
+    ens.step();
+    for(size_t l = 0; l < ENSEMBLE_LANES; l++) sourceRicker(true, 1.0, &ens.e[ens.at(src % s, src / s, l)], t, ENSEMBLE_WTS);
+  }
+  *te = timer.nsecsElapsed();
+
+  size_t bad = 0;
+  *ts = 0.0;
+  for(size_t l = 0; l < ENSEMBLE_LANES; l++) {
+    CSpaceEH2d space(s, s);
+    for(size_t n = 0; n < s * s; n++) {
+      space.c[n].cee = 1.0;
+      space.c[n].ceh = ((n % s) < s / 2) ? DTDS2D * IMP0 : DTDS2D * IMP0 / (1.0 + l);
+      space.c[n].ch1h = space.c[n].ch2h = 1.0;
+      space.c[n].ch1e = space.c[n].ch2e = DTDS2D / IMP0;
+    }
+    space.reset();
+    timer.start();
+    for(size_t t = 0; t < ENSEMBLE_STEPS; t++) {
+      space.update_h();
+      space.update_e();
+      sourceRicker(true, 1.0, &space.c[src].e, t, ENSEMBLE_WTS);
+    }
+    *ts += timer.nsecsElapsed();
+    for(size_t n = 0; n < s * s; n++) {
+      size_t m = ens.at(n % s, n / s, l);
+      if((space.c[n].e != ens.e[m]) || (space.c[n].h1 != ens.h1[m]) || (space.c[n].h2 != ens.h2[m])) {
+        bad++;
+        break;
+      }
+    }
+  }
+  return bad;
+}
+
+int ensembleMain()
+{
+  double ts, te;
+  size_t bad1 = ensemble1d(&ts, &te);
+  printf("%s ensemble: 1D %d cells, %d lanes, %d steps: %d lanes differ, %.1fx scalar\n", TITLE,
+         ENSEMBLE_SIZE1D, ENSEMBLE_LANES, ENSEMBLE_STEPS, int(bad1), ts / te);
+  size_t bad2 = ensemble2d(&ts, &te);
+  printf("%s ensemble: 2D %dx%d cells, %d lanes, %d steps: %d lanes differ, %.1fx scalar\n", TITLE,
+         ENSEMBLE_SIZE2D, ENSEMBLE_SIZE2D, ENSEMBLE_LANES, ENSEMBLE_STEPS, int(bad2), ts / te);
+  return (bad1 + bad2 == 0) ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+
+#include "defs.h"
+#include "ensemble1d.h"
+
+// NOTES:
+//  1) D22 update only, the lane loops are the innermost (vectorized) loops
+//  2) lane results match CSpaceEH1d (with CAbc2o1d) runs bit for bit
+
+#define L ENSEMBLE_LANES
+
+CEnsemble1d::CEnsemble1d(size_t s)
+{
+  size = s;
+  e = new double[size * L];
+  h = new double[size * L];
+  cee = new double[size * L];
+  ceh = new double[size * L];
+  chh = new double[size * L];
+  che = new double[size * L];
+  abc = false;
+  for(size_t n = 0; n < size * L; n++) { // free-space
+    cee[n] = 1.0;
+    ceh[n] = IMP0;
+    chh[n] = 1.0;
+    che[n] = 1.0 / IMP0;
+  }
+}
+
+CEnsemble1d::~CEnsemble1d()
+{
+  delete[] e;
+  delete[] h;
+  delete[] cee;
+  delete[] ceh;
+  delete[] chh;
+  delete[] che;
+}
+
+void CEnsemble1d::reset()
+{
+  for(size_t n = 0; n < size * L; n++) e[n] = h[n] = 0.0;
+  for(int i = 0; i < 3; i++)
+    for(int j = 0; j < 2; j++)
+      for(size_t l = 0; l < L; l++) prevL[i][j][l] = prevR[i][j][l] = 0.0;
+}
+
+void CEnsemble1d::set_abc()
+{
+  for(size_t l = 0; l < L; l++) {
+    // left coefficients
+    double temp1 = sqrt(ceh[at(0, l)] * che[at(0, l)]);
+    double temp2 = 1.0 / temp1 + 2.0 + temp1;
+    abcCoefL[0][l] = -(1.0 / temp1 - 2.0 + temp1) / temp2;
+    abcCoefL[1][l] = -2.0 * (temp1 - 1.0 / temp1) / temp2;
+    abcCoefL[2][l] = 4.0 * (temp1 + 1.0 / temp1) / temp2;
+
+    // right coefficients
+    temp1 = sqrt(ceh[at(size - 1, l)] * che[at(size - 1, l)]);
+    temp2 = 1.0 / temp1 + 2.0 + temp1;
+    abcCoefR[0][l] = -(1.0 / temp1 - 2.0 + temp1) / temp2;
+    abcCoefR[1][l] = -2.0 * (temp1 - 1.0 / temp1) / temp2;
+    abcCoefR[2][l] = 4.0 * (temp1 + 1.0 / temp1) / temp2;
+  }
+  abc = true;
+}
+
+void CEnsemble1d::update_e() // calculated using Ez Hy
+{
+  for (size_t i = 1; i < size; i++) {  // don't update lowest index e-field
+    double *ei = e + i * L;
+    const double *hi = h + i * L;
+    const double *hm = hi - L;
+    const double *ce = cee + i * L;
+    const double *ch = ceh + i * L;
+    for (size_t l = 0; l < L; l++)
+      ei[l] = (ce[l] * ei[l]) + (ch[l] * (hi[l] - hm[l]));
+  }
+  if(!abc) return;
+
+  for (size_t l = 0; l < L; l++) { // left abc (e-field)
+    e[l] =
+        abcCoefL[0][l] * (e[2 * L + l] + prevL[0][1][l])
+      + abcCoefL[1][l] * (prevL[0][0][l] + prevL[2][0][l] - e[L + l] - prevL[1][1][l])
+      + abcCoefL[2][l] * prevL[1][0][l] - prevL[2][1][l];
+  }
+  for (int i = 0; i < 3; i++) {
+    for (size_t l = 0; l < L; l++) {
+      prevL[i][1][l] = prevL[i][0][l];
+      prevL[i][0][l] = e[i * L + l];
+    }
+  }
+}
+
+void CEnsemble1d::update_h() // calculated using Ez Hy
+{
+  for (size_t i = 0; i < size - 1; i++) { // don't update highest index h-field
+    double *hi = h + i * L;
+    const double *ei = e + i * L;
+    const double *ep = ei + L;
+    const double *ch = chh + i * L;
+    const double *ce = che + i * L;
+    for (size_t l = 0; l < L; l++)
+      hi[l] = (ch[l] * hi[l]) + (ce[l] * (ep[l] - ei[l]));
+  }
+  if(!abc) return;
+
+  double *hr[3] = {h + (size - 1) * L, h + (size - 2) * L, h + (size - 3) * L}; // right abc (h-field)
+  for (size_t l = 0; l < L; l++) {
+    hr[0][l] =
+        abcCoefR[0][l] * (hr[2][l] + prevR[0][1][l])
+      + abcCoefR[1][l] * (prevR[0][0][l] + prevR[2][0][l] - hr[1][l] - prevR[1][1][l])
+      + abcCoefR[2][l] * prevR[1][0][l] - prevR[2][1][l];
+  }
+  for (int i = 0; i < 3; i++) {
+    for (size_t l = 0; l < L; l++) {
+      prevR[i][1][l] = prevR[i][0][l];
+      prevR[i][0][l] = hr[i][l];
+    }
+  }
+}
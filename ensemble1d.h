@@ -0,0 +1,56 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef ENSEMBLE1D_H
+#define ENSEMBLE1D_H
+
+#include <stdlib.h>
+
+#include "defs.h"
+
+// ENSEMBLE_LANES independent 1D simulations in SIMD lanes
+// fields & coefficients are stored field-of-vectors: [cell][lane],
+// so every lane shares the stencil but has its own materials & sources
+class CEnsemble1d
+{
+public:
+  CEnsemble1d(size_t s);
+  ~CEnsemble1d();
+
+  size_t size;
+  double *e, *h;         // fields
+  double *cee, *ceh;     // space parameters
+  double *chh, *che;
+  size_t at(size_t i, size_t lane) const {return i * ENSEMBLE_LANES + lane;}
+
+  void reset();
+  void set_abc();        // second order abc's (after material initialization)
+  void update_e();       // & left abc
+  void update_h();       // & right abc
+private:
+  bool abc;
+  double abcCoefL[3][ENSEMBLE_LANES], abcCoefR[3][ENSEMBLE_LANES];
+  double prevL[3][2][ENSEMBLE_LANES], prevR[3][2][ENSEMBLE_LANES]; // [position][time][lane]
+};
+
+#endif // ENSEMBLE1D_H
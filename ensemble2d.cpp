@@ -0,0 +1,134 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+
+#include "defs.h"
+#include "ensemble2d.h"
+
+// NOTES:
+//  1) the lane loops are the innermost (vectorized) loops
+//  2) lane results match CSpaceEH2d runs bit for bit
+
+#define L ENSEMBLE_LANES
+
+CEnsemble2d::CEnsemble2d(size_t sx, size_t sy)
+{
+  sX = sx;   // size
+  sY = sy;
+  sXY = sx * sy;
+  e = new double[sXY * L];
+  h1 = new double[sXY * L];
+  h2 = new double[sXY * L];
+  cee = new double[sXY * L];
+  ceh = new double[sXY * L];
+  ch1h = new double[sXY * L];
+  ch1e = new double[sXY * L];
+  ch2h = new double[sXY * L];
+  ch2e = new double[sXY * L];
+  for(size_t n = 0; n < sXY * L; n++) { // free-space
+    cee[n] = 1.0;
+    ceh[n] = DTDS2D * IMP0;
+    ch1h[n] = ch2h[n] = 1.0;
+    ch1e[n] = ch2e[n] = DTDS2D / IMP0;
+  }
+}
+
+CEnsemble2d::~CEnsemble2d()
+{
+  delete[] e;
+  delete[] h1;
+  delete[] h2;
+  delete[] cee;
+  delete[] ceh;
+  delete[] ch1h;
+  delete[] ch1e;
+  delete[] ch2h;
+  delete[] ch2e;
+}
+
+void CEnsemble2d::reset()
+{
+  for(size_t n = 0; n < sXY * L; n++) e[n] = h1[n] = h2[n] = 0.0;
+}
+
+void CEnsemble2d::update_e() // calculated using Ez Hx Hy
+{
+  for (size_t j = 1; j < sY; j++) row_e(j); // don't update lowest e-fields
+}
+
+void CEnsemble2d::update_h() // calculated using Ez Hx Hy
+{
+  for (size_t j = 0; j < sY - 1; j++) row_h(j); // don't update highest h-fields
+}
+
+void CEnsemble2d::step() // h-field row j, then e-field row j (still in cache)
+{
+  for (size_t j = 0; j < sY; j++) {
+    if(j < sY - 1) row_h(j);
+    if(j > 0) row_e(j);
+  }
+}
+
+void CEnsemble2d::row_e(size_t j)
+{
+  for (size_t i = 1; i < sX; i++) {
+    size_t n = (i + j * sX) * L;
+    double *en = e + n;
+    const double *ce = cee + n;
+    const double *ch = ceh + n;
+    const double *h2n = h2 + n;
+    const double *h2m = h2n - L;       // i - 1
+    const double *h1n = h1 + n;
+    const double *h1m = h1n - sX * L;  // j - 1
+    double a[L]; // (no aliasing: vectorizes)
+    for (size_t l = 0; l < L; l++)
+      a[l] = ce[l] * en[l] + ch[l] * ((h2n[l] - h2m[l]) - (h1n[l] - h1m[l]));
+    for (size_t l = 0; l < L; l++) en[l] = a[l];
+  }
+}
+
+void CEnsemble2d::row_h(size_t j)
+{
+  for (size_t i = 0; i < sX - 1; i++) {
+    size_t n = (i + j * sX) * L;
+    double *h1n = h1 + n;
+    double *h2n = h2 + n;
+    const double *en = e + n;
+    const double *ey = en + sX * L;    // j + 1
+    const double *ex = en + L;         // i + 1
+    const double *c1h = ch1h + n;
+    const double *c1e = ch1e + n;
+    const double *c2h = ch2h + n;
+    const double *c2e = ch2e + n;
+    double a1[L], a2[L]; // (no aliasing: vectorizes)
+    for (size_t l = 0; l < L; l++) {
+      a1[l] = c1h[l] * h1n[l] - c1e[l] * (ey[l] - en[l]);
+      a2[l] = c2h[l] * h2n[l] + c2e[l] * (ex[l] - en[l]);
+    }
+    for (size_t l = 0; l < L; l++) {
+      h1n[l] = a1[l];
+      h2n[l] = a2[l];
+    }
+  }
+}
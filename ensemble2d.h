@@ -0,0 +1,57 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef ENSEMBLE2D_H
+#define ENSEMBLE2D_H
+
+#include <stdlib.h>
+
+#include "defs.h"
+
+// ENSEMBLE_LANES independent 2D (Ez Hx Hy) simulations in SIMD lanes
+// fields & coefficients are stored field-of-vectors: [cell][lane]
+// (field updates only: boundaries are pec, abc's & tfsf are per model)
+class CEnsemble2d
+{
+public:
+  CEnsemble2d(size_t sx, size_t sy);
+  ~CEnsemble2d();
+
+  size_t sX, sY;  // size
+  size_t sXY;
+  double *e, *h1, *h2;   // fields
+  double *cee, *ceh;     // space parameters
+  double *ch1h, *ch1e;
+  double *ch2h, *ch2e;
+  size_t at(size_t i, size_t j, size_t lane) const {return (i + j * sX) * ENSEMBLE_LANES + lane;}
+
+  void reset();
+  void update_e();
+  void update_h();
+  void step();    // update_h() & update_e() in one (row lagged) sweep
+private:
+  void row_e(size_t j);
+  void row_h(size_t j);
+};
+
+#endif // ENSEMBLE2D_H
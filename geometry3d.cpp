@@ -0,0 +1,44 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include "geometry3d.h"
+
+CGeometry3d::CGeometry3d(size_t sx, size_t sy, size_t sz)
+{
+  sX = sx;   // size
+  sY = sy;
+  sZ = sz;
+  sXY = sx * sy;
+  sXYZ = sx * sy * sz;
+  mx = new unsigned char[sXYZ];
+  my = new unsigned char[sXYZ];
+  mz = new unsigned char[sXYZ];
+  for(size_t i = 0; i < sXYZ; i++) mx[i] = my[i] = mz[i] = 0;
+}
+
+CGeometry3d::~CGeometry3d()
+{
+  delete[] mx;
+  delete[] my;
+  delete[] mz;
+}
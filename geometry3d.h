@@ -0,0 +1,42 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef GEOMETRY3D_H
+#define GEOMETRY3D_H
+
+#include <stdlib.h>
+
+// material index grid, built once and shared read-only by batch runs
+// each e-field component has its own index (0: background)
+class CGeometry3d
+{
+public:
+  CGeometry3d(size_t sx, size_t sy, size_t sz);
+  ~CGeometry3d();
+
+  size_t sX, sY, sZ;  // size
+  size_t sXY, sXYZ;  // size
+  unsigned char *mx, *my, *mz; // material indices (ex, ey, ez)
+};
+
+#endif // GEOMETRY3D_H
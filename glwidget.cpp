@@ -34,6 +34,11 @@ rugis@msu.edu
 #include "spaceEH2d.h"
 #include "spaceEH3d.h"
 #include "stopwatch.h"
+#include "profiler.h"
+#include "solver.h"
+#include "snapshot.h"
+#include "replay.h"
+#include "builder.h"
 
 #include "glwidget.h"
 
@@ -50,6 +55,11 @@ rugis@msu.edu
 #define AP (1000.0/ARR)  // ANIMATE_PERIOD (ms)
 #define RAA (0.005)      // ROTATE_ANIMATION_ANGLE per ms
 #define RDS 0.2          // ROTATE_DRAG_SCALE
+#define BP 100           // BUILD_POLL_PERIOD (ms)
+#define FSB 0.7          // FULL_SPEED_STEP_BUDGET (frame fraction, the rest draws)
+#define SPF_MAX 4096     // STEPS_PER_FRAME maximum
+#define RP 1000          // STEP_RATE_PERIOD (ms)
+#define RB (512 << 20)   // REPLAY_BUDGET (bytes)
 
 #define INIT_ROTATE (0.0)
 #define ROTATE_MIN (-180.0)
@@ -119,6 +129,16 @@ GLWidget::GLWidget(QWidget *parent)
   setFocusPolicy(Qt::ClickFocus); // accept key presses
 
   model = NULL;
+  for(int d = 0; d < 3; d++) models[d] = NULL;
+  builder = NULL;
+#ifdef SOLVER_THREAD
+  solver = NULL;
+  snapshot = NULL;
+  replay = NULL;
+  replay_pos = 0;
+  view_serial = 0;
+  view_changed = true;
+#endif
   model_dim = 3;
   animate = false;
   run = false;
@@ -136,17 +156,34 @@ GLWidget::GLWidget(QWidget *parent)
   rotate_angle = INIT_ROTATE;
   tilt_angle = INIT_TILT;
   step_period = MSP;
+  full_speed = false;
+  spf = 1;
+  steps = rate_steps = 0;
+  step_rate = 0.0;
 
   animation_timer = new QTimer(this);
   connect(animation_timer, SIGNAL(timeout()), this, SLOT(animation_tick()));
   calcs_timer = new QTimer(this);
   connect(calcs_timer, SIGNAL(timeout()), this, SLOT(calcs_tick()));
+  build_timer = new QTimer(this);
+  connect(build_timer, SIGNAL(timeout()), this, SLOT(build_tick()));
   EH_timer = new CStopwatch("calc:");
   Paint_timer = new CStopwatch("draw:");
+#if defined(PROFILE_COUNTERS) && !defined(SOLVER_THREAD)
+  profiler.attach_counters(); // steps on this thread
+#endif
 }
 
 GLWidget::~GLWidget()
 {
+#ifdef SOLVER_THREAD
+  delete solver; // stops the thread
+  delete snapshot;
+  delete replay;
+#endif
+  delete builder; // waits for it
+  makeCurrent(); // models free their display lists
+  for(int d = 0; d < 3; d++) delete models[d];
 }
 
 #ifdef USE_LEAP
@@ -163,6 +200,7 @@ void GLWidget::onExit(const Leap::Controller& controller) {
 }
 
 void GLWidget::onFrame(const Leap::Controller& controller) {
+  if(model == NULL) return; // building
   const Leap::Frame frame = controller.frame(); // most recent frame
 
   if(!leap_drag) {
@@ -195,15 +233,8 @@ void GLWidget::onFrame(const Leap::Controller& controller) {
       else if(gesture.type() == Leap::Gesture::TYPE_CIRCLE) {
         Leap::CircleGesture circle(gesture);
         if(circle.radius() < CIRCLE_RADIUS_MIN) continue;
-        if((circle.normal().z < 0.0) & !run) {  // clockwise
-          run = true;
-          calcs_timer->start(step_period);
-          update_status();
-        }
-        if((circle.normal().z > 0.0) & run) {  // counter-clockwise
-          run = false;
-          update_status();
-        }
+        if((circle.normal().z < 0.0) & !run) toggle_run(); // clockwise
+        if((circle.normal().z > 0.0) & run) toggle_run();  // counter-clockwise
       }
     }
     return;
@@ -258,21 +289,26 @@ void GLWidget::get_leap_status(QString &s)
 
 void GLWidget::keyPressEvent(QKeyEvent *e)
 {
+  if((model == NULL) && (e->text() != "X")) return; // building
+  if(!notice.isEmpty()) {
+    notice = "";
+    update_status();
+  }
   if(e->text() == "1") {
     model_dim = 1;
-    reset_model();
+    select_model();
     update_status();
     if(!run && !animate) updateGL();
   }
   else if(e->text() == "2") {
     model_dim = 2;
-    reset_model();
+    select_model();
     update_status();
     if(!run && !animate) updateGL();
   }
   else if(e->text() == "3") {
     model_dim = 3;
-    reset_model();
+    select_model();
     update_status();
     if(!run && !animate) updateGL();
   }
@@ -308,13 +344,20 @@ void GLWidget::keyPressEvent(QKeyEvent *e)
     if(!run && !animate) updateGL();
   }
   else if(e->text() == "F") {
+#ifdef SOLVER_THREAD
+    solver->lock.lock();
     model->inc_field_type();
+    solver->lock.unlock();
+    solver->refresh();
+#else
+    model->inc_field_type();
+#endif
     update_status();
     if(!run && !animate) updateGL();
   }
   else if(e->text() == "f") {
     step_period /= SPCF;
-    if(run) calcs_timer->start(step_period);
+    set_period();
   }
   else if(e->text() == "H") {
     show_help();
@@ -329,9 +372,40 @@ void GLWidget::keyPressEvent(QKeyEvent *e)
       if(!run && !animate) updateGL();
     }
   }
+#ifdef SOLVER_THREAD
+  else if(e->text() == "[") { // replay: back
+    if(run) toggle_run();
+    if(replay_pos < replay->frames() - 1) replay_pos++;
+    view_changed = true;
+    update_status();
+    if(!animate) updateGL();
+  }
+  else if(e->text() == "]") { // replay: forward (to live)
+    if(replay_pos > 0) replay_pos--;
+    view_changed = true;
+    update_status();
+    if(!animate) updateGL();
+  }
+#endif
+  else if(e->text() == "M") {
+    full_speed ^= 1;
+    set_period();
+    update_status();
+  }
   else if(e->text() == "L") {
     show_splash(this);
   }
+#ifdef PROFILE
+  else if(e->text() == "P") {
+    profiler.write("profile.json");
+    profiler.write("profile.csv");
+  }
+#endif
+  else if(e->text() == "W") { // the displayed fields
+    if(model->write_surface("isosurface.obj")) notice = "wrote isosurface.obj";
+    else notice = (model_dim == 3) ? "can't write isosurface.obj" : "no isosurface (3D only)";
+    update_status();
+  }
   else if(e->text() == "Q") {
     model->alpha_fac *= 1.1;
     if(!run && !animate) updateGL();
@@ -348,13 +422,22 @@ void GLWidget::keyPressEvent(QKeyEvent *e)
   }
   else if(e->text() == "r") toggle_run();
   else if(e->text() == "R") {
+#ifdef SOLVER_THREAD
+    solver->lock.lock();
+    model->reset();
+    solver->lock.unlock();
+    replay->clear();
+    replay_pos = 0;
+    solver->refresh();
+#else
     model->reset();
+#endif
     point_size = 1.0;
     if(!run && !animate) updateGL();
   }
   else if(e->text() == "s") {
     step_period *= SPCF;
-    if(run) calcs_timer->start(step_period);
+    set_period();
   }
   else if(e->text() == "S") {
     display_stereo ^= 1;
@@ -402,9 +485,45 @@ void GLWidget::keyReleaseEvent(QKeyEvent *e)
 
 void GLWidget::toggle_run()
 {
+  if(model == NULL) return; // building (no solver yet)
   run ^= 1;
+#ifdef SOLVER_THREAD
+  replay_pos = 0; // live
+  view_changed = true;
+#endif
+  update_status();
+#ifdef SOLVER_THREAD
+  solver->running = run;
+  if(run) calcs_timer->start(AP); // frame rate, the solver paces itself
+  else solver->refresh(); // the final state
+  steps = 0;
+  rate_steps = size_t(int(solver->steps)); // the solver counts from the model build
+#else
+  if(run) set_period();
+  steps = rate_steps = 0;
+#endif
+  step_rate = 0.0;
+  rate_time.start();
+}
+
+void GLWidget::set_period() // model step pacing
+{
+#ifdef SOLVER_THREAD
+  if(solver != NULL) solver->period = full_speed ? 0 : int(step_period);
+#else
+  spf = 1;
+  if(run) calcs_timer->start(full_speed ? AP : step_period);
+#endif
+}
+
+void GLWidget::update_rate(size_t n) // steps/s, n: steps taken
+{
+  int t = rate_time.elapsed();
+  if(t < RP) return;
+  step_rate = 1000.0 * (n - rate_steps) / t;
+  rate_steps = n;
+  rate_time.restart();
   update_status();
-  if(run) calcs_timer->start(step_period);
 }
 
 void GLWidget::initializeGL()
@@ -467,7 +586,7 @@ void GLWidget::initializeGL()
     glEnd();
   glEndList();
 
-  reset_model(); // here because relies on OpenGL
+  select_model(); // here because relies on OpenGL
   update_status();
   show_splash(this);
 }
@@ -509,6 +628,7 @@ void GLWidget::draw()
   glScaled(scale_factor, scale_factor, scale_factor);
 
   model->face = forward_face(tilt_angle, rotate_angle, &(model->xp), &(model->yp), &(model->zp));
+  model->zoom = qMax(cwidth, cheight) * scale_factor / (WSF * SH);
   if(display_axis) glCallList(axes);
   model->draw();
   glPopMatrix();
@@ -535,11 +655,59 @@ void GLWidget::draw()
   //*******************************************
 }
 
+void GLWidget::draw_progress() // model build progress bar
+{
+  float w = this->size().width();
+  float h = this->size().height();
+  float x = 0.25 * w + 0.005 * w * int(CModel::build_progress);
+  glMatrixMode(GL_PROJECTION);
+  glPushMatrix();
+  glLoadIdentity();
+  glOrtho(0, w, h, 0, 0, 1);
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glLoadIdentity();
+
+  glColor4f(0.5, 0.5, 0.5, 1.0);
+  glBegin(GL_LINE_LOOP);
+  glVertex2f(0.25 * w, 0.5 * h - 5); glVertex2f(0.25 * w, 0.5 * h + 5);
+  glVertex2f(0.75 * w, 0.5 * h + 5); glVertex2f(0.75 * w, 0.5 * h - 5);
+  glEnd();
+  glBegin(GL_QUADS);
+  glVertex2f(0.25 * w, 0.5 * h - 5); glVertex2f(0.25 * w, 0.5 * h + 5);
+  glVertex2f(x, 0.5 * h + 5); glVertex2f(x, 0.5 * h - 5);
+  glEnd();
+
+  glPopMatrix();
+  glMatrixMode(GL_PROJECTION);
+  glPopMatrix();
+}
+
 void GLWidget::paintGL()
 {
   if(time_all) time_paint = true;
   if(time_paint) Paint_timer->start();  // time the paint?
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if(model == NULL) { // building
+    draw_progress();
+    return;
+  }
+  PROFILE_BEGIN(PHASE_DRAW);
+#ifdef SOLVER_THREAD
+  if(snapshot->fresh()) view_changed = true;
+  model->view = snapshot->front(); // the latest published fields
+  if(replay_pos > 0) { // or a past frame
+    int tag;
+    const float *v = replay->frame(replay->frames() - 1 - replay_pos, &tag);
+    if((v != NULL) && (tag == model->field_type)) model->view = v;
+    else {
+      replay_pos = 0; // gone (field type changed)
+      view_changed = true;
+    }
+  }
+  if(view_changed) model->view_id = ++view_serial; // else cached colors hold
+  view_changed = false;
+#endif
 
   if(display_stereo) {
     glMatrixMode(GL_PROJECTION);
@@ -556,6 +724,7 @@ void GLWidget::paintGL()
     draw();
     glPopMatrix();
   } else draw();
+  PROFILE_END(PHASE_DRAW);
 
   if(time_paint) { // display the elapsed time
     Paint_timer->stop();
@@ -591,9 +760,32 @@ void GLWidget::animation_tick()
 
 void GLWidget::calcs_tick()
 {
+  if(model == NULL) return; // building
+#ifdef SOLVER_THREAD
+  if(time_all) update_status(); // solver step time
+  update_rate(size_t(int(solver->steps)));
+  if(!run) calcs_timer->stop();
+  if(!animate && snapshot->fresh()) updateGL();
+#else
   if(time_all) time_field = true;
   if(time_field) EH_timer->start();  // time the EH field update?
-  model->step();
+  if(full_speed) { // steps per frame adapted to the step budget of a frame
+    QTime t;
+    t.start();
+    for(int i = 0; i < spf; i++) model->step();
+    steps += spf;
+    double r = FSB * AP / qMax(t.elapsed(), 1);
+    if(r > 2.0) r = 2.0;
+    if(r < 0.5) r = 0.5;
+    spf = int(spf * r + 0.5);
+    if(spf < 1) spf = 1;
+    if(spf > SPF_MAX) spf = SPF_MAX;
+  }
+  else {
+    model->step();
+    steps++;
+  }
+  update_rate(steps);
   if(time_field) { // display the elapsed time
     EH_timer->stop();
     time_field = false;
@@ -601,6 +793,7 @@ void GLWidget::calcs_tick()
   }
   if(!run) calcs_timer->stop();
   if(!animate) updateGL();
+#endif
 }
 
 void GLWidget::reset_projection()
@@ -619,38 +812,94 @@ void GLWidget::reset_projection()
   //glScalef(sw, sh, 1.0 / WSF);
 }
 
-void GLWidget::reset_model()
+void GLWidget::select_model()
 {
-  if(model != NULL) delete model;
-  switch(model_dim) {
-  case 1:
-    glClearColor(BLACK, 1.0);
-    model = new CModel1D(this);
-    break;
-  case 2:
-    glClearColor(BLACK, 1.0);
-    model = new CModel2D(this);
-    break;
-  case 3:
-    glClearColor(LIGHTGREY, 1.0);
-    model = new CModel3D(this);
-    break;
+#ifdef SOLVER_THREAD
+  delete solver; // stops the thread
+  delete snapshot;
+  delete replay;
+  solver = NULL;
+  snapshot = NULL;
+  replay = NULL;
+  replay_pos = 0;
+  view_changed = true;
+#endif
+  model = models[model_dim - 1]; // built on first use, then kept (fields & view)
+  if(model == NULL) { // build on a worker thread (see build_tick)
+    builder = new CBuilder(model_dim, this);
+    builder->start();
+    build_timer->start(BP);
+    return;
+  }
+  if(model_dim == 3) glClearColor(LIGHTGREY, 1.0);
+  else glClearColor(BLACK, 1.0);
+  model->set_profile();
+#ifdef SOLVER_THREAD
+  snapshot = new CSnapshot(model->snap_size());
+  replay = new CReplay(model->snap_size(), RB);
+  solver = new CSolver(model, snapshot);
+  solver->replay = replay;
+  set_period();
+  steps = rate_steps = 0; // a new step count
+  solver->running = run;
+  solver->refresh();
+  solver->start();
+  if(run) calcs_timer->start(AP);
+#endif
+}
+
+void GLWidget::build_tick()
+{
+  if(builder->isRunning()) { // progress
+    update_status();
+    updateGL();
+    return;
   }
+  build_timer->stop();
+  CModel *m = builder->take();
+  if(!m->error.isEmpty()) fatalError(m->error); // on the GUI thread
+  models[builder->dim - 1] = m;
+  delete builder;
+  builder = NULL;
+  makeCurrent();
+  m->init_gl(); // OpenGL resources, on this thread
+  select_model();
+  update_status();
+  updateGL();
 }
 
 void GLWidget::update_status() {  // display status in title bar
   QString s = TITLE;
   s.append(": ");
+  if(model == NULL) {
+    s.append("building " + QString::number(model_dim) + "D model "
+             + QString::number(int(CModel::build_progress)) + "%");
+    parentWidget()->setWindowTitle(s);
+    return;
+  }
   model->get_status(s);
   if(display_ortho) s.append(", ortho");
-  if(run) s.append(", running");
+  if(run) s.append(", running " + QString::number(int(step_rate)) + " steps/s");
+  if(full_speed) s.append(", full speed");
+#ifdef SOLVER_THREAD
+  if(replay_pos > 0) s.append(", replay -" + QString::number(replay_pos) + "/"
+                              + QString::number(replay->frames() - 1));
+#endif
   if(time_all) {
+#ifdef SOLVER_THREAD
+    s.append(", calc:" + QString::number(int(solver->step_ms)));
+#else
     s.append(", " + EH_timer->message);
+#endif
     s.append(", " + Paint_timer->message);
+#ifdef PROFILE
+    profiler.get_status(s);
+#endif
   }
 #ifdef USE_LEAP
   get_leap_status(s);
 #endif
+  if(!notice.isEmpty()) s.append(", " + notice);
   //main_window->setWindowTitle(s);
   parentWidget()->setWindowTitle(s);
 }
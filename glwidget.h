@@ -39,6 +39,10 @@ rugis@msu.edu
 class CModel;
 class Window;
 class CStopwatch;
+class CSolver;
+class CBuilder;
+class CSnapshot;
+class CReplay;
 
 #ifdef USE_LEAP
 class GLWidget : public QGLWidget, public Leap::Listener
@@ -56,6 +60,7 @@ public:
 public slots:
   void animation_tick();
   void calcs_tick();
+  void build_tick();
 signals:
   void timeout();
 
@@ -85,7 +90,7 @@ private:
   void get_leap_status(QString &s);
 #endif
 
-  QTimer *animation_timer, *calcs_timer;
+  QTimer *animation_timer, *calcs_timer, *build_timer;
   QTime elapsed_time;
   QPoint lastPos;
   GLdouble scale_factor;
@@ -104,15 +109,34 @@ private:
   bool display_ortho, display_axis, display_stereo;
   bool time_all, time_field, time_paint;
   double step_period;
-  CModel *model;
+  bool full_speed;       // adaptive frame skipping: step flat out, draw at frame rate
+  int spf;               // steps per frame (full speed, !SOLVER_THREAD)
+  size_t steps, rate_steps; // steps taken (!SOLVER_THREAD) & at the last rate
+  QTime rate_time;
+  double step_rate;      // steps/s
+  QString notice;        // last file write (title bar, until the next key)
+  CModel *model;         // the current model
+  CModel *models[3];     // built models, per dimension (kept when switching)
+  CBuilder *builder;     // model under construction (NULL: none)
   CStopwatch *EH_timer, *Paint_timer;
+#ifdef SOLVER_THREAD
+  CSolver *solver;      // model stepping thread
+  CSnapshot *snapshot;  // its display output
+  CReplay *replay;      // its recent display output
+  int replay_pos;       // frames back from the newest (0: live)
+  unsigned int view_serial; // model view contents ids (never reused)
+  bool view_changed;    // the next paint's view contents are new
+#endif
 
   void draw();
-  void reset_model();
+  void draw_progress();
+  void select_model();
   void reset_projection();
   void update_status();
 
   void toggle_run();
+  void set_period();
+  void update_rate(size_t n);
 
 };
 
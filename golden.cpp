@@ -0,0 +1,238 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+#include "model.h"
+#include "model1d.h"
+#include "model2d.h"
+#include "model3d.h"
+#include "golden.h"
+
+// NOTES:
+//  1) the configurations are the ones compiled into model1d/2d/3d.cpp
+//     (modeldef.cpp M0000-M2000/F0000-F2000 is not built: it predates the
+//     per dimension models), a changed configuration shows as changed cells
+//  2) summaries are taken at GOLDEN_CHECKS evenly spaced steps, so a drift
+//     can be located in time
+//  3) tolerances are relative to the golden value (absolute near zero)
+
+#define GOLDEN_FILE "golden.txt"
+#define GOLDEN_CHECKS 4
+#define GOLDEN_REORDER_TOL 1.0e-12 // reordered summation (double)
+#define GOLDEN_FLOAT_TOL 1.0e-4    // single precision fields
+#define GOLDEN_ZERO 1.0e-30        // absolute tolerance floor
+
+static const struct {const char *name; int dim; int steps;} golden_models[] = {
+  {"1d", 1, 1000}, {"2d", 2, 400}, {"3d", 3, 200}
+};
+
+CChecksum::CChecksum()
+{
+  for(int f = 0; f < 2; f++) {
+    n[f] = 0;
+    sum2[f] = max[f] = 0.0;
+  }
+  hash = 14695981039346656037ULL;
+}
+
+void CChecksum::add(int f, double v)
+{
+  if(v == 0.0) v = 0.0; // -0.0
+  unsigned char b[sizeof(double)];
+  memcpy(b, &v, sizeof(double));
+  for(size_t i = 0; i < sizeof(double); i++) {
+    hash ^= b[i];
+    hash *= 1099511628211ULL;
+  }
+  n[f]++;
+  sum2[f] += v * v;
+  if(fabs(v) > max[f]) max[f] = fabs(v);
+}
+
+double CChecksum::norm(int f) const
+{
+  return sqrt(sum2[f]);
+}
+
+// ***********************************************************************
+// golden records: model step cells hash |e| |h| max|e| max|h|
+// ***********************************************************************
+class CGoldenRecord
+{
+public:
+  std::string model;
+  int step;
+  size_t cells;
+  unsigned long long hash;
+  double v[4]; // norm e, norm h, max e, max h
+};
+
+static bool close_to(double a, double g, double tol)
+{
+  double d = fabs(a - g);
+  return (d <= GOLDEN_ZERO) || (d <= tol * fabs(g));
+}
+
+static void record(const char *name, int step, const CModel *model, CGoldenRecord *r)
+{
+  CChecksum c;
+  model->checksum(c);
+  r->model = name;
+  r->step = step;
+  r->cells = model->cells();
+  r->hash = c.hash;
+  r->v[0] = c.norm(0);
+  r->v[1] = c.norm(1);
+  r->v[2] = c.max[0];
+  r->v[3] = c.max[1];
+}
+
+static void run(size_t m, CModel *model, std::vector<CGoldenRecord> &runs)
+{
+  int steps = golden_models[m].steps;
+  for(int s = 1; s <= steps; s++) {
+    model->step();
+    if((s % (steps / GOLDEN_CHECKS)) == 0) {
+      CGoldenRecord r;
+      record(golden_models[m].name, s, model, &r);
+      runs.push_back(r);
+    }
+  }
+}
+
+static bool read_golden(const char *file, std::vector<CGoldenRecord> &g)
+{
+  std::ifstream in(file);
+  if(!in) return false;
+  std::string line;
+  while(std::getline(in, line)) {
+    if(line.empty() || (line[0] == '#')) continue;
+    std::istringstream s(line);
+    CGoldenRecord r;
+    s >> r.model >> r.step >> r.cells >> std::hex >> r.hash >> std::dec;
+    for(int i = 0; i < 4; i++) s >> r.v[i];
+    if(s) g.push_back(r);
+  }
+  return true;
+}
+
+static bool write_golden(const char *file, const std::vector<CGoldenRecord> &g)
+{
+  std::ofstream out(file);
+  if(!out) return false;
+  out << "# " << TITLE << " golden output: model step cells hash |e| |h| max|e| max|h|\n";
+  out.precision(17);
+  for(size_t i = 0; i < g.size(); i++) {
+    out << g[i].model << " " << g[i].step << " " << g[i].cells << " "
+        << std::hex << g[i].hash << std::dec;
+    for(int j = 0; j < 4; j++) out << " " << g[i].v[j];
+    out << "\n";
+  }
+  return true;
+}
+
+// ***********************************************************************
+// -golden [exact|reorder|float|update] [file]
+// ***********************************************************************
+int goldenMain(int argc, char *argv[])
+{
+  const char *mode = (argc > 2) ? argv[2] : "exact";
+  const char *file = (argc > 3) ? argv[3] : GOLDEN_FILE;
+  bool update = (strcmp(mode, "update") == 0);
+  double tol = 0.0;
+  if(strcmp(mode, "reorder") == 0) tol = GOLDEN_REORDER_TOL;
+  else if(strcmp(mode, "float") == 0) tol = GOLDEN_FLOAT_TOL;
+  else if(!update && (strcmp(mode, "exact") != 0)) {
+    printf("%s golden: unknown mode %s (exact, reorder, float or update)\n", TITLE, mode);
+    return 2;
+  }
+
+  std::vector<CGoldenRecord> runs;
+  for(size_t m = 0; m < sizeof(golden_models) / sizeof(golden_models[0]); m++) {
+    if(golden_models[m].dim == 1) {
+      CModel1D *model = new CModel1D(NULL);
+      run(m, model, runs);
+      delete model;
+    }
+    else if(golden_models[m].dim == 2) {
+      CModel2D *model = new CModel2D(NULL);
+      run(m, model, runs);
+      delete model;
+    }
+    else {
+      CModel3D *model = new CModel3D(NULL);
+      if(!model->error.isEmpty()) {
+        printf("%s golden: %s\n", TITLE, model->error.toStdString().c_str());
+        delete model;
+        return 2;
+      }
+      run(m, model, runs);
+      delete model;
+    }
+  }
+
+  if(update) {
+    if(!write_golden(file, runs)) {
+      printf("%s golden: can't write %s\n", TITLE, file);
+      return 2;
+    }
+    printf("%s golden: %d records to %s\n", TITLE, int(runs.size()), file);
+    return 0;
+  }
+
+  std::vector<CGoldenRecord> golden;
+  if(!read_golden(file, golden)) {
+    printf("%s golden: can't read %s (run -golden update)\n", TITLE, file);
+    return 2;
+  }
+  static const char *names[4] = {"|e|", "|h|", "max|e|", "max|h|"};
+  int failed = 0;
+  for(size_t i = 0; i < runs.size(); i++) {
+    const CGoldenRecord &r = runs[i];
+    const CGoldenRecord *g = NULL;
+    for(size_t j = 0; j < golden.size(); j++)
+      if((golden[j].model == r.model) && (golden[j].step == r.step)) g = &golden[j];
+    std::string why;
+    if(g == NULL) why = "no golden record";
+    else if(g->cells != r.cells) why = "cells changed (configuration?)";
+    else if((tol == 0.0) && (g->hash != r.hash)) why = "hash";
+    for(int k = 0; (g != NULL) && why.empty() && (k < 4); k++) {
+      if(!close_to(r.v[k], g->v[k], tol)) {
+        char b[128];
+        sprintf(b, "%s %.17g (golden %.17g)", names[k], r.v[k], g->v[k]);
+        why = b;
+      }
+    }
+    printf("%s step %5d: %s %s\n", r.model.c_str(), r.step, why.empty() ? "ok" : "FAIL", why.c_str());
+    if(!why.empty()) failed++;
+  }
+  printf("%s golden (%s): %d of %d checks failed\n", TITLE, mode, failed, int(runs.size()));
+  return failed ? 1 : 0;
+}
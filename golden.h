@@ -0,0 +1,48 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <stdlib.h>
+
+// field summary of a model state: L2 norm & largest magnitude of the e & h
+// fields, and a hash of their bits (in cell order)
+class CChecksum
+{
+public:
+  CChecksum();
+  void add(int f, double v); // f: 0 = e, 1 = h (scaled by IMP0)
+  double norm(int f) const;
+
+  size_t n[2];                // values
+  double sum2[2], max[2];
+  unsigned long long hash;    // FNV-1a, all values in order
+};
+
+// golden output regression (-golden [exact|reorder|float|update] [file])
+// steps each model's compiled configuration & compares checkpoint summaries
+// with a golden file: exact (bits), reorder (summation order) or float
+// tolerances; update rewrites the file
+int goldenMain(int argc, char *argv[]);
+
+#endif // GOLDEN_H
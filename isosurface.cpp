@@ -0,0 +1,298 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <math.h>
+#include <fstream>
+
+#include "defs.h"
+#include "isosurface.h"
+#include "parallel.h"
+
+#define ISO_BLOCK 8 // block edge (cubes)
+
+// NOTES:
+//  1) a cube vertex is the mean of its edge crossings (linear interpolation),
+//     its normal the negated corner difference gradient
+//  2) each interior grid edge crossing the level gives a quad from the four
+//     cube vertices around it, wound to face down the gradient; edges on the
+//     grid faces have fewer cubes, so the surface is open there
+//  3) a crossed edge lies in every block holding one of its cubes (blocks
+//     share their face samples), so all four cube vertices exist and the
+//     cube table needs no clearing between extractions
+//  4) vertices & triangles are gathered per block, then concatenated in
+//     block order: the mesh is the same for any number of threads
+
+CIsosurface::CIsosurface(size_t x, size_t y, size_t z)
+{
+  sx = x;
+  sy = y;
+  sz = z;
+  field = new float[sx * sy * sz];
+  for(size_t n = 0; n < sx * sy * sz; n++) field[n] = 0.0;
+  cube = new GLuint[(sx - 1) * (sy - 1) * (sz - 1)];
+  bx = (sx - 2) / ISO_BLOCK + 1;
+  by = (sy - 2) / ISO_BLOCK + 1;
+  bz = (sz - 2) / ISO_BLOCK + 1;
+  blocks = bx * by * bz;
+  active = 0;
+  ckey = -1;
+  cview = 0;
+  calpha = 0.0;
+}
+
+CIsosurface::~CIsosurface()
+{
+  delete[] field;
+  delete[] cube;
+}
+
+// extraction state & the per block passes (each on the thread pool)
+class CIsoBlocks : public CLoop
+{
+public:
+  enum {SPAN, VERTICES, PLACE, QUADS, CONCAT};
+  CIsoBlocks(CIsosurface *s, float level) : s(s), level(level) {}
+  void run(long first, long last) {
+    for(long b = first; b < last; b++) {
+      if(pass == SPAN) span_block(b);
+      else if(pass == VERTICES) vertex_block(b);
+      else if(pass == PLACE) place_block(b);
+      else if(pass == QUADS) quad_block(b);
+      else for(size_t m = 0; m < bt[b].size(); m++) s->index[toff[b] + m] = bt[b][m];
+    }
+  }
+
+  CIsosurface *s;
+  float level;
+  int pass;
+  std::vector<char> span;                // blocks spanning the level
+  std::vector<long> act;                 // their indices
+  std::vector<std::vector<float> > bv, bn; // vertices & normals, per active block
+  std::vector<std::vector<size_t> > bc;  // their cubes
+  std::vector<std::vector<GLuint> > bt;  // triangles
+  std::vector<size_t> voff, toff;        // vertex & index offsets
+
+private:
+  void range(long b, size_t *i0, size_t *i1) const { // block cubes [i0, i1)
+    size_t c[3] = {s->sx - 1, s->sy - 1, s->sz - 1};
+    size_t o[3] = {b % s->bx, (b / s->bx) % s->by, b / (s->bx * s->by)};
+    for(int d = 0; d < 3; d++) {
+      i0[d] = o[d] * ISO_BLOCK;
+      i1[d] = (i0[d] + ISO_BLOCK < c[d]) ? i0[d] + ISO_BLOCK : c[d];
+    }
+  }
+  void span_block(long b);
+  void vertex_block(long a);
+  void place_block(long a);
+  void quad_block(long a);
+};
+
+void CIsoBlocks::span_block(long b) // min/max of the block samples
+{
+  size_t i0[3], i1[3];
+  range(b, i0, i1);
+  const float *f = s->field;
+  size_t sx = s->sx;
+  size_t sxy = s->sx * s->sy;
+  float fmin = f[i0[0] + i0[1] * sx + i0[2] * sxy];
+  float fmax = fmin;
+  for(size_t k = i0[2]; k <= i1[2]; k++) { // samples, inclusive
+    for(size_t j = i0[1]; j <= i1[1]; j++) {
+      const float *r = f + j * sx + k * sxy;
+      for(size_t i = i0[0]; i <= i1[0]; i++) {
+        if(r[i] < fmin) fmin = r[i];
+        if(r[i] > fmax) fmax = r[i];
+      }
+    }
+  }
+  span[b] = (fmin <= level) && (fmax > level);
+}
+
+void CIsoBlocks::vertex_block(long a) // cube vertices of active block a
+{
+  size_t i0[3], i1[3];
+  range(act[a], i0, i1);
+  const float *f = s->field;
+  size_t sx = s->sx;
+  size_t sxy = s->sx * s->sy;
+  size_t cx = s->sx - 1;
+  size_t cxy = (s->sx - 1) * (s->sy - 1);
+  for(size_t k = i0[2]; k < i1[2]; k++) {
+    for(size_t j = i0[1]; j < i1[1]; j++) {
+      for(size_t i = i0[0]; i < i1[0]; i++) {
+        float c[8]; // corners, bit 0: +x, bit 1: +y, bit 2: +z
+        int mask = 0;
+        for(int q = 0; q < 8; q++) {
+          c[q] = f[(i + (q & 1)) + (j + ((q >> 1) & 1)) * sx + (k + (q >> 2)) * sxy];
+          if(c[q] > level) mask |= 1 << q;
+        }
+        if((mask == 0) || (mask == 255)) continue;
+        float p[3] = {0.0, 0.0, 0.0};
+        int m = 0;
+        for(int q = 0; q < 8; q++) { // the 12 edges, from their low corner
+          for(int d = 0; d < 3; d++) {
+            int r = q | (1 << d);
+            if((r == q) || (((mask >> q) ^ (mask >> r)) & 1) == 0) continue;
+            float t = (level - c[q]) / (c[r] - c[q]);
+            for(int e = 0; e < 3; e++) p[e] += ((q >> e) & 1) + ((e == d) ? t : 0.0);
+            m++;
+          }
+        }
+        float g[3] = {0.0, 0.0, 0.0};
+        for(int q = 0; q < 8; q++) {
+          for(int d = 0; d < 3; d++) if(((q >> d) & 1) == 0) g[d] += c[q | (1 << d)] - c[q];
+        }
+        float l = sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+        if(l == 0.0) l = 1.0;
+        bv[a].push_back(i + p[0] / m);
+        bv[a].push_back(j + p[1] / m);
+        bv[a].push_back(k + p[2] / m);
+        for(int d = 0; d < 3; d++) bn[a].push_back(-g[d] / l);
+        bc[a].push_back(i + j * cx + k * cxy);
+      }
+    }
+  }
+}
+
+void CIsoBlocks::place_block(long a) // block vertices into the mesh
+{
+  for(size_t v = 0; v < bc[a].size(); v++) {
+    size_t m = voff[a] + v;
+    s->cube[bc[a][v]] = m;
+    for(int e = 0; e < 3; e++) {
+      s->vertex[3 * m + e] = bv[a][3 * v + e];
+      s->normal[3 * m + e] = bn[a][3 * v + e];
+    }
+  }
+}
+
+void CIsoBlocks::quad_block(long a) // quads around crossed edges
+{
+  const float *f = s->field;
+  size_t sx = s->sx;
+  size_t sxy = s->sx * s->sy;
+  size_t cx = s->sx - 1;
+  size_t cxy = (s->sx - 1) * (s->sy - 1);
+  std::vector<GLuint> &t = bt[a];
+  for(size_t v = 0; v < bc[a].size(); v++) {
+    size_t n = bc[a][v];
+    size_t i = n % cx;
+    size_t j = (n / cx) % (s->sy - 1);
+    size_t k = n / cxy;
+    float f0 = f[i + j * sx + k * sxy];
+    bool in = f0 > level;
+    for(int d = 0; d < 3; d++) { // the edge from the low corner along d
+      size_t u, w; // the other two axes (right handed: d = u x w)
+      if(d == 0) {if((j == 0) || (k == 0)) continue; u = cx; w = cxy;}
+      else if(d == 1) {if((k == 0) || (i == 0)) continue; u = cxy; w = 1;}
+      else {if((i == 0) || (j == 0)) continue; u = 1; w = cx;}
+      float f1 = (d == 0) ? f[i + 1 + j * sx + k * sxy] :
+                 ((d == 1) ? f[i + (j + 1) * sx + k * sxy] : f[i + j * sx + (k + 1) * sxy]);
+      if((f1 > level) == in) continue;
+      GLuint q0 = s->cube[n - u - w];
+      GLuint q1 = s->cube[n - w];
+      GLuint q2 = s->cube[n];
+      GLuint q3 = s->cube[n - u];
+      if(in) {t.push_back(q0); t.push_back(q1); t.push_back(q2);
+              t.push_back(q0); t.push_back(q2); t.push_back(q3);}
+      else   {t.push_back(q0); t.push_back(q2); t.push_back(q1);
+              t.push_back(q0); t.push_back(q3); t.push_back(q2);}
+    }
+  }
+}
+
+void CIsosurface::extract(float level)
+{
+  CIsoBlocks e(this, level);
+
+  // block min/max: skip blocks that can't hold the surface
+  e.span.resize(blocks);
+  e.pass = CIsoBlocks::SPAN;
+  parallelFor(blocks, e);
+  for(size_t b = 0; b < blocks; b++) if(e.span[b]) e.act.push_back(b);
+  active = e.act.size();
+
+  // cube vertices, per block
+  e.bv.resize(active);
+  e.bn.resize(active);
+  e.bc.resize(active);
+  e.pass = CIsoBlocks::VERTICES;
+  parallelFor(active, e);
+  e.voff.resize(active + 1, 0);
+  for(size_t a = 0; a < active; a++) e.voff[a + 1] = e.voff[a] + e.bc[a].size();
+  vertex.resize(3 * e.voff[active]);
+  normal.resize(3 * e.voff[active]);
+  e.pass = CIsoBlocks::PLACE;
+  parallelFor(active, e);
+
+  // quads around crossed edges, per block
+  e.bt.resize(active);
+  e.pass = CIsoBlocks::QUADS;
+  parallelFor(active, e);
+  e.toff.resize(active + 1, 0);
+  for(size_t a = 0; a < active; a++) e.toff[a + 1] = e.toff[a] + e.bt[a].size();
+  index.resize(e.toff[active]);
+  e.pass = CIsoBlocks::CONCAT;
+  parallelFor(active, e);
+}
+
+void CIsosurface::draw() const
+{
+  if(index.empty()) return;
+  GLfloat diffuse[] = {0.3, 0.5, 0.8, 1.0};
+  GLfloat specular[] = {0.5, 0.5, 0.5, 1.0};
+  GLfloat shininess[] = {20.0};
+  glPushAttrib(GL_ENABLE_BIT | GL_LIGHTING_BIT);
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+  glEnable(GL_LIGHTING);
+  glEnable(GL_NORMALIZE);
+  glDisable(GL_CULL_FACE); // seen from either side
+  glLightModeli(GL_LIGHT_MODEL_TWO_SIDE, GL_TRUE);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE, diffuse);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, specular);
+  glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, shininess);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_NORMAL_ARRAY);
+  glVertexPointer(3, GL_FLOAT, 0, &vertex[0]);
+  glNormalPointer(GL_FLOAT, 0, &normal[0]);
+  glDrawElements(GL_TRIANGLES, index.size(), GL_UNSIGNED_INT, &index[0]);
+  glPopClientAttrib();
+  glPopAttrib();
+}
+
+bool CIsosurface::write_obj(const char *file) const
+{
+  std::ofstream out(file);
+  if(!out) return false;
+  out << "# " << TITLE << " isosurface: " << vertex.size() / 3 << " vertices, "
+      << triangles() << " triangles (grid units)\n";
+  for(size_t v = 0; v < vertex.size(); v += 3)
+    out << "v " << vertex[v] << " " << vertex[v + 1] << " " << vertex[v + 2] << "\n";
+  for(size_t v = 0; v < normal.size(); v += 3)
+    out << "vn " << normal[v] << " " << normal[v + 1] << " " << normal[v + 2] << "\n";
+  for(size_t t = 0; t < index.size(); t += 3) {
+    out << "f";
+    for(int c = 0; c < 3; c++) out << " " << index[t + c] + 1 << "//" << index[t + c] + 1;
+    out << "\n";
+  }
+  return bool(out);
+}
@@ -0,0 +1,64 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef ISOSURFACE_H
+#define ISOSURFACE_H
+
+#include <QtOpenGL>
+#include <stdlib.h>
+#include <vector>
+
+class CIsoBlocks;
+
+// the level surface of a scalar grid (sx x sy x sz samples) as an indexed
+// triangle mesh, extracted by surface nets (one vertex per crossed cube)
+// the grid is split into blocks, blocks whose min/max don't span the level
+// are skipped, the rest are extracted in parallel
+// no OpenGL calls outside draw(), so it can be built off the GUI thread
+class CIsosurface
+{
+public:
+  CIsosurface(size_t sx, size_t sy, size_t sz);
+  ~CIsosurface();
+
+  size_t sx, sy, sz;          // samples
+  float *field;               // sample values (owner filled), x fastest
+  std::vector<float> vertex;  // xyz per vertex (grid units)
+  std::vector<float> normal;  // unit normal per vertex (down the gradient)
+  std::vector<GLuint> index;  // triangles
+  int ckey;                   // surface state (owner defined, -1 = none)
+  unsigned int cview;         // surface state: field values (owner defined serial)
+  double calpha;              // surface state: alpha factor
+  size_t blocks, active;      // last extraction: all & spanning blocks
+
+  void extract(float level);
+  void draw() const;           // in grid units
+  bool write_obj(const char *file) const; // in grid units (as CMesh loads)
+  size_t triangles() const {return index.size() / 3;}
+
+private:
+  friend class CIsoBlocks;
+  size_t bx, by, bz;          // blocks per axis
+  GLuint *cube;               // vertex of each crossed cube
+};
+
+#endif // ISOSURFACE_H
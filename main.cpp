@@ -23,13 +23,25 @@ rugis@msu.edu
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QGLFormat>
+#include <string.h>
 
 #include "utils.h"
 #include "defs.h"
 #include "window.h"
+#include "batch.h"
+#include "offscreen.h"
+#include "bench.h"
+#include "golden.h"
+#include "ensemble.h"
 
 int main(int argc, char *argv[])
 {
+  if((argc > 1) && (strcmp(argv[1], "-batch") == 0)) return batchMain(argc, argv); // no display
+  if((argc > 1) && (strcmp(argv[1], "-ensemble") == 0)) return ensembleMain(); // no display
+  if((argc > 1) && (strcmp(argv[1], "-render") == 0)) return renderMain(argc, argv); // no display
+  if((argc > 1) && (strcmp(argv[1], "-bench") == 0)) return benchMain(argc, argv); // no display
+  if((argc > 1) && (strcmp(argv[1], "-golden") == 0)) return goldenMain(argc, argv); // no display
+
   QApplication app(argc, argv);
   if (!QGLFormat::hasOpenGL()) fatalError("This system does not support OpenGL.");
   Window window;
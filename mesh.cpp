@@ -0,0 +1,329 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QtOpenGL>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "mesh.h"
+
+#define LEAF 4        // bvh leaf size (triangles)
+#define MAX_DEPTH 48  // bvh depth
+
+CMesh::CMesh()
+{
+}
+
+bool CMesh::load(const char *file, double s, double x, double y, double z)
+{
+  vtx.clear();
+  tri.clear();
+  nodes.clear();
+  size_t l = strlen(file);
+  bool obj = (l > 4) && ((strcmp(file + l - 4, ".obj") == 0) || (strcmp(file + l - 4, ".OBJ") == 0));
+  if(!(obj ? load_obj(file) : load_stl(file))) return false;
+  if(tri.empty() || !closed()) return false;
+  for(size_t i = 0; i < vtx.size(); i += 3) {
+    vtx[i] = s * vtx[i] + x;
+    vtx[i + 1] = s * vtx[i + 1] + y;
+    vtx[i + 2] = s * vtx[i + 2] + z;
+  }
+  build();
+  return true;
+}
+
+bool CMesh::load_stl(const char *file) // binary or ascii
+{
+  std::ifstream in(file, std::ios::in | std::ios::binary);
+  if(!in) return false;
+  in.seekg(0, std::ios::end);
+  size_t size = in.tellg();
+  in.seekg(0, std::ios::beg);
+  char header[84];
+  if(size < 84 || !in.read(header, 84)) return false;
+  unsigned int n;
+  memcpy(&n, header + 80, 4);
+  if(size == 84 + 50 * size_t(n)) { // binary (little endian)
+    char rec[50];
+    for(size_t i = 0; i < n; i++) {
+      if(!in.read(rec, 50)) return false;
+      for(int v = 0; v < 3; v++) {
+        float f[3];
+        memcpy(f, rec + 12 + 12 * v, 12);
+        tri.push_back(vtx.size() / 3);
+        vtx.push_back(f[0]); vtx.push_back(f[1]); vtx.push_back(f[2]);
+      }
+    }
+    return true;
+  }
+  if(strncmp(header, "solid", 5) != 0) return false;
+  in.seekg(0, std::ios::beg); // ascii
+  std::string w;
+  while(in >> w) {
+    if(w != "vertex") continue;
+    double v[3];
+    if(!(in >> v[0] >> v[1] >> v[2])) return false;
+    tri.push_back(vtx.size() / 3);
+    vtx.push_back(v[0]); vtx.push_back(v[1]); vtx.push_back(v[2]);
+  }
+  tri.resize(tri.size() - tri.size() % 3);
+  return true;
+}
+
+bool CMesh::load_obj(const char *file) // vertices & faces (fan triangulated)
+{
+  std::ifstream in(file);
+  if(!in) return false;
+  std::string line;
+  while(std::getline(in, line)) {
+    std::istringstream ls(line);
+    std::string w;
+    ls >> w;
+    if(w == "v") {
+      double v[3];
+      if(!(ls >> v[0] >> v[1] >> v[2])) return false;
+      vtx.push_back(v[0]); vtx.push_back(v[1]); vtx.push_back(v[2]);
+    }
+    else if(w == "f") {
+      std::vector<size_t> f;
+      while(ls >> w) {
+        long i = atol(w.c_str()); // v, v/vt, v/vt/vn, v//vn
+        if(i < 0) i += vtx.size() / 3 + 1; // relative
+        if((i < 1) || (size_t(i) > vtx.size() / 3)) return false;
+        f.push_back(i - 1);
+      }
+      for(size_t i = 2; i < f.size(); i++) {
+        tri.push_back(f[0]); tri.push_back(f[i - 1]); tri.push_back(f[i]);
+      }
+    }
+  }
+  return true;
+}
+
+// vertices welded by position (STL repeats them per triangle), then every
+// edge must be used an even number of times
+class CVertexLess
+{
+public:
+  CVertexLess(const double *v) : v(v) {}
+  bool operator()(size_t i, size_t j) const {
+    const double *a = v + 3 * i;
+    const double *b = v + 3 * j;
+    if(a[0] != b[0]) return a[0] < b[0];
+    if(a[1] != b[1]) return a[1] < b[1];
+    return a[2] < b[2];
+  }
+private:
+  const double *v;
+};
+
+bool CMesh::closed() const
+{
+  size_t nv = vtx.size() / 3;
+  std::vector<size_t> order(nv), id(nv);
+  for(size_t i = 0; i < nv; i++) order[i] = i;
+  CVertexLess less(&vtx[0]);
+  std::sort(order.begin(), order.end(), less);
+  for(size_t i = 0, k = 0; i < nv; i++) {
+    if((i > 0) && less(order[i - 1], order[i])) k++;
+    id[order[i]] = k;
+  }
+  std::vector<std::pair<size_t, size_t> > edges;
+  edges.reserve(tri.size());
+  for(size_t i = 0; i < tri.size(); i += 3) {
+    for(int e = 0; e < 3; e++) {
+      size_t a = id[tri[i + e]];
+      size_t b = id[tri[i + (e + 1) % 3]];
+      if(a == b) continue; // degenerate
+      edges.push_back((a < b) ? std::make_pair(a, b) : std::make_pair(b, a));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  for(size_t i = 0; i < edges.size();) {
+    size_t j = i;
+    while((j < edges.size()) && (edges[j] == edges[i])) j++;
+    if((j - i) % 2) return false; // a boundary edge
+    i = j;
+  }
+  return true;
+}
+
+// bvh: triangles sorted by centroid, median split on the longest axis
+class CCentroidLess
+{
+public:
+  CCentroidLess(const double *c, int a) : c(c), a(a) {}
+  bool operator()(size_t i, size_t j) const {return c[3 * i + a] < c[3 * j + a];}
+private:
+  const double *c;
+  int a;
+};
+
+void CMesh::build()
+{
+  size_t n = tri.size() / 3;
+  std::vector<size_t> order(n);
+  std::vector<double> centre(3 * n);
+  for(size_t i = 0; i < n; i++) {
+    order[i] = i;
+    for(int a = 0; a < 3; a++)
+      centre[3 * i + a] = (vtx[3 * tri[3 * i] + a] + vtx[3 * tri[3 * i + 1] + a]
+                          + vtx[3 * tri[3 * i + 2] + a]) / 3.0;
+  }
+  nodes.clear();
+  split(order, centre, 0, n, 0);
+  std::vector<size_t> t(tri.size());
+  for(size_t i = 0; i < n; i++)
+    for(int v = 0; v < 3; v++) t[3 * i + v] = tri[3 * order[i] + v];
+  tri.swap(t);
+}
+
+size_t CMesh::split(std::vector<size_t> &order, const std::vector<double> &centre,
+                    size_t first, size_t count, int depth)
+{
+  size_t m = nodes.size();
+  CNode node;
+  for(int a = 0; a < 3; a++) {
+    node.b0[a] = HUGE_VAL;
+    node.b1[a] = -HUGE_VAL;
+  }
+  double c0[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+  double c1[3] = {-HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+  for(size_t i = first; i < first + count; i++) {
+    for(int a = 0; a < 3; a++) {
+      for(int v = 0; v < 3; v++) {
+        double x = vtx[3 * tri[3 * order[i] + v] + a];
+        if(x < node.b0[a]) node.b0[a] = x;
+        if(x > node.b1[a]) node.b1[a] = x;
+      }
+      double x = centre[3 * order[i] + a];
+      if(x < c0[a]) c0[a] = x;
+      if(x > c1[a]) c1[a] = x;
+    }
+  }
+  node.first = first;
+  node.count = count;
+  nodes.push_back(node);
+  if((count <= LEAF) || (depth >= MAX_DEPTH)) return m; // leaf
+
+  int a = 0;
+  for(int i = 1; i < 3; i++) if(c1[i] - c0[i] > c1[a] - c0[a]) a = i;
+  size_t h = count / 2;
+  std::nth_element(order.begin() + first, order.begin() + first + h,
+                   order.begin() + first + count, CCentroidLess(&centre[0], a));
+  split(order, centre, first, h, depth + 1); // left child is m + 1
+  size_t r = split(order, centre, first + h, count - h, depth + 1);
+  nodes[m].first = r;                    // right child
+  nodes[m].count = 0;
+  return m;
+}
+
+void CMesh::bounds(double *b0, double *b1) const
+{
+  for(int a = 0; a < 3; a++) {
+    b0[a] = nodes.empty() ? 0.0 : nodes[0].b0[a];
+    b1[a] = nodes.empty() ? 0.0 : nodes[0].b1[a];
+  }
+}
+
+// edge function, > 0 for p left of a->b
+static double edge(const double *a, const double *b, const double *p, int u, int v)
+{
+  return (b[u] - a[u]) * (p[v] - a[v]) - (b[v] - a[v]) * (p[u] - a[u]);
+}
+
+// points on an edge belong to one side only (top-left rule)
+static bool owns(const double *a, const double *b, int u, int v)
+{
+  return (b[v] < a[v]) || ((b[v] == a[v]) && (b[u] < a[u]));
+}
+
+int CMesh::crossings(int axis, const double *p, double *t) const
+{
+  if(nodes.empty()) return 0;
+  int u = (axis + 1) % 3;
+  int v = (axis + 2) % 3;
+  int n = 0;
+  size_t stack[2 * MAX_DEPTH + 2];
+  int sp = 0;
+  stack[sp++] = 0;
+  while(sp > 0) {
+    const CNode &node = nodes[stack[--sp]];
+    if((p[u] < node.b0[u]) || (p[u] > node.b1[u])
+      || (p[v] < node.b0[v]) || (p[v] > node.b1[v])) continue; // missed
+    if(node.count == 0) { // interior
+      stack[sp++] = node.first;
+      stack[sp++] = &node - &nodes[0] + 1;
+      continue;
+    }
+    for(size_t i = node.first; i < node.first + node.count; i++) {
+      const double *a = &vtx[3 * tri[3 * i]];
+      const double *b = &vtx[3 * tri[3 * i + 1]];
+      const double *c = &vtx[3 * tri[3 * i + 2]];
+      double area = edge(a, b, c, u, v);
+      if(area == 0.0) continue; // edge on
+      if(area < 0.0) {std::swap(b, c); area = -area;} // counter clockwise
+      double w0 = edge(b, c, p, u, v);
+      double w1 = edge(c, a, p, u, v);
+      double w2 = edge(a, b, p, u, v);
+      if((w0 < 0.0) || (w1 < 0.0) || (w2 < 0.0)) continue;
+      if((w0 == 0.0) && !owns(b, c, u, v)) continue;
+      if((w1 == 0.0) && !owns(c, a, u, v)) continue;
+      if((w2 == 0.0) && !owns(a, b, u, v)) continue;
+      if(n < MAX_CROSSINGS) t[n++] = (w0 * a[axis] + w1 * b[axis] + w2 * c[axis]) / area;
+    }
+  }
+  std::sort(t, t + n);
+  return n & ~1; // parity (closed meshes only: an odd count is a grazing ray)
+}
+
+void CMesh::draw() const
+{
+  glEnable(GL_LIGHTING);
+  glBegin(GL_TRIANGLES);
+  for(size_t i = 0; i < tri.size(); i += 3) {
+    const double *a = &vtx[3 * tri[i]];
+    const double *b = &vtx[3 * tri[i + 1]];
+    const double *c = &vtx[3 * tri[i + 2]];
+    double e1[3], e2[3];
+    for(int k = 0; k < 3; k++) {
+      e1[k] = b[k] - a[k];
+      e2[k] = c[k] - a[k];
+    }
+    double nx = e1[1] * e2[2] - e1[2] * e2[1];
+    double ny = e1[2] * e2[0] - e1[0] * e2[2];
+    double nz = e1[0] * e2[1] - e1[1] * e2[0];
+    double l = sqrt(nx * nx + ny * ny + nz * nz);
+    if(l == 0.0) continue;
+    glNormal3d(nx / l, ny / l, nz / l);
+    glVertex3dv(a);
+    glVertex3dv(b);
+    glVertex3dv(c);
+  }
+  glEnd();
+  glDisable(GL_LIGHTING);
+}
@@ -0,0 +1,61 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <vector>
+
+#include "shape.h"
+
+// closed triangle mesh (binary or ascii STL, OBJ) as a shape
+// crossings are found by parity ray-casting through a bounding volume
+// hierarchy, rays through shared edges & vertices count once;
+// open meshes are rejected at load (an odd crossing count has no inside)
+class CMesh : public CShape
+{
+public:
+  CMesh();
+  // load & place the mesh: grid = s * file + (x, y, z), false: unreadable or open
+  bool load(const char *file, double s = 1.0, double x = 0.0, double y = 0.0, double z = 0.0);
+  void bounds(double *b0, double *b1) const;
+  int crossings(int axis, const double *p, double *t) const;
+  void draw() const; // in grid units
+  size_t triangles() const {return tri.size() / 3;}
+private:
+  struct CNode {
+    double b0[3], b1[3]; // bounding box
+    size_t first, count; // triangles (leaf), or first = child (count = 0)
+  };
+  std::vector<double> vtx;   // vertices (x, y, z)
+  std::vector<size_t> tri;   // triangle vertex indices
+  std::vector<CNode> nodes;  // bvh, root first
+  bool load_stl(const char *file);
+  bool load_obj(const char *file);
+  bool closed() const; // every edge shared by an even number of triangles
+  void build();
+  size_t split(std::vector<size_t> &order, const std::vector<double> &centre,
+               size_t first, size_t count, int depth);
+};
+
+#endif // MESH_H
@@ -25,17 +25,38 @@ rugis@msu.edu
 
 #include "model.h"
 
+QAtomicInt CModel::build_progress;
+
 CModel::CModel(GLWidget *parent)
 {
   p = parent;
   display_bbox = true;
   dither = false;
+  dither_key = 0;
   display_yee = false;
   display_boundary = false;
   alpha_fac = 1.0;
   skip = 1;
   cut_type = field_type = 0;
+  view = NULL;
+  view_id = 0;
+  zoom = 0.0;
+  bbox = 0;
+}
+
+CModel::~CModel()
+{
+  if(bbox != 0) glDeleteLists(bbox, 1);
+}
 
+unsigned int CModel::dither_seed(unsigned int frame) const
+{
+  if((p != NULL) && p->run) return dither_key + 0x9e3779b9u * (frame + 1); // live: new jitter
+  return dither_key;
+}
+
+void CModel::init_gl()
+{
   // create data bounding box
   BBOX_GEN(bbox, 3.0, 0.3, 0.3, 0.3, -0.5, -0.5, -0.5, 0.5, 0.5, 0.5)
 }
@@ -24,8 +24,11 @@ rugis@msu.edu
 #define MODEL_H
 
 #include <QGLWidget>
+#include <QAtomicInt>
 
 class GLWidget;
+class CPointCloud;
+class CChecksum;
 
 class CModel
 {
@@ -34,16 +37,32 @@ public:
   bool display_yee;
   bool display_boundary;
   bool dither;
+  unsigned int dither_key; // dither pattern (a new one per reset)
   int cut_type, field_type;
   int skip; // display thinning: skip cells
   double alpha_fac;
   bool xp, yp, zp; // x, y, z positive facing?
   int face;        // the near facing axis: 1=x, 2=y, 3=z
+  const float *view; // display snapshot (SOLVER_THREAD)
+  unsigned int view_id; // changes with the view contents (color cache)
+  double zoom;       // display pixels per data cube edge (0: unknown)
+  static QAtomicInt build_progress; // construction progress (percent)
+  QString error;     // construction failure (empty: none), for the caller to report
 
+  virtual ~CModel();        // OpenGL resources freed (context current if init_gl was)
+  virtual void init_gl();  // OpenGL resources (needs a current context)
+  virtual void set_profile() const {} // profiler cells & flops (the current model)
   virtual void reset() {}
   virtual void step() {}
   virtual void draw() const {}
+  virtual CPointCloud *points() const {return NULL;} // no OpenGL (NULL: none)
+  virtual size_t cells() const {return 0;} // grid cells
+  virtual size_t snap_size() const {return 0;}
+  virtual void snap(float *) const {} // copy the displayed field(s)
+  virtual void checksum(CChecksum &) const {} // all e & h fields (golden output)
+  virtual bool write_surface(const char *) const {return false;} // isosurface (OBJ, 3D)
   virtual void get_status(QString &s) const {s = "";}
+  unsigned int dither_seed(unsigned int frame) const; // running: per frame, else per reset
   virtual void inc_field_type() {}
   virtual void inc_cut_type() {}
 
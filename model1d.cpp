@@ -31,6 +31,8 @@ rugis@msu.edu
 #include "spaceEH1d.h"
 #include "abc1o1d.h"
 #include "abc2o1d.h"
+#include "profiler.h"
+#include "golden.h"
 
 #include "model1d.h"
 
@@ -77,6 +79,22 @@ CModel1D::CModel1D(GLWidget *parent) : CModel(parent)
 
   set_material(); // space & material
   reset();        // space & material
+  set_profile();
+}
+
+CModel1D::~CModel1D()
+{
+  delete abc2o1d;
+  delete abc1o1d;
+  delete space1d;
+}
+
+void CModel1D::set_profile() const
+{
+  profiler.set_cells(SIZEX, sizeof(Ccell1d));
+  profiler.set_flops(PHASE_H, 4.0); // per cell (D22)
+  profiler.set_flops(PHASE_E, 4.0);
+  profiler.set_flops(PHASE_STEP, 8.0);
 }
 
 // ***********************************************************************
@@ -220,7 +238,11 @@ void CModel1D::set_material()
 // ***********************************************************************
 void CModel1D::step()
 {
+  PROFILE_BEGIN(PHASE_STEP);
+  PROFILE_BEGIN(PHASE_H);
   space1d->update_h(); // ***** update magnetic field *****
+  PROFILE_END(PHASE_H);
+  PROFILE_BEGIN(PHASE_SOURCE);
 
 #ifdef GAUSSIAN_LHS
   #define WTS 30
@@ -311,6 +333,9 @@ void CModel1D::step()
   sourceRicker(true, 0.4, &(space1d->c[SRC_POS].e), time_step + 1, WTS);
 #endif
 
+  PROFILE_END(PHASE_SOURCE);
+
+  PROFILE_BEGIN(PHASE_ABC);
 #ifdef FIELD_PMC
   #define POS (5 * (SIZEX / 6))
   space1d->c[POS].h = 0.0; // embedded electricmagnetic conductor
@@ -324,8 +349,13 @@ void CModel1D::step()
 #ifdef ABC_SECOND_ORDER
   abc2o1d->update_h();
 #endif
+  PROFILE_END(PHASE_ABC);
 
+  PROFILE_BEGIN(PHASE_E);
   space1d->update_e();  // ***** update electric field *****
+  PROFILE_END(PHASE_E);
+
+  PROFILE_BEGIN(PHASE_ABC);
 
 #ifdef ABC_SIMPLE_RHS
   space1d->c[SIZEX - 1].h = space1d->c[SIZEX - 2].h; // simple RHS h-field ABC
@@ -340,8 +370,10 @@ void CModel1D::step()
   #define POS (5 * (SIZEX / 6))
   space1d->c[POS].e = 0.0; // embedded electric conductor
 #endif
+  PROFILE_END(PHASE_ABC);
 
   time_step++;
+  PROFILE_END(PHASE_STEP);
 }
 
 void CModel1D::reset()
@@ -379,25 +411,70 @@ void CModel1D::inc_field_type()
   if(++field_type > 3) field_type = 0;
 }
 
+size_t CModel1D::cells() const
+{
+  return SIZEX;
+}
+
+size_t CModel1D::snap_size() const
+{
+  return 4 * SIZEX; // e, eMax, eMin, IMP0 * h
+}
+
+void CModel1D::snap(float *v) const
+{
+  PROFILE_BEGIN(PHASE_OUTPUT);
+  for(int i = 0; i < SIZEX; i++) {
+    v[i] = space1d->c[i].e;
+    v[SIZEX + i] = space1d->eMax[i];
+    v[2 * SIZEX + i] = space1d->eMin[i];
+    v[3 * SIZEX + i] = IMP0 * space1d->c[i].h;
+  }
+  PROFILE_END(PHASE_OUTPUT);
+}
+
+void CModel1D::checksum(CChecksum &c) const
+{
+  for(size_t i = 0; i < SIZEX; i++) {
+    c.add(0, space1d->c[i].e);
+    c.add(1, IMP0 * space1d->c[i].h);
+  }
+}
+
 void CModel1D::draw() const  // right handed space
 {
+#ifdef SOLVER_THREAD
+  const float *e = view;
+  const float *emax = view + SIZEX;
+  const float *emin = view + 2 * SIZEX;
+  const float *h = view + 3 * SIZEX;
+  #define E(i) e[i]
+  #define EMAX(i) emax[i]
+  #define EMIN(i) emin[i]
+  #define H(i) h[i]
+#else
+  #define E(i) space1d->c[i].e
+  #define EMAX(i) space1d->eMax[i]
+  #define EMIN(i) space1d->eMin[i]
+  #define H(i) (IMP0 * space1d->c[i].h)
+#endif
   glBegin(GL_POINTS);
   if(field_type != 2) { // display Ez
     glColor3d(BRIGHTYELLOW);
     for(int i = 0; i < SIZEX; i++)
-      glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, space1d->c[i].e);
+      glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, E(i));
     if(field_type == 1) {
       glColor3d(BRIGHTRED);
       for(int i = 0; i < SIZEX; i++) {
-          glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, space1d->eMax[i]);
-          glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, space1d->eMin[i]);
+          glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, EMAX(i));
+          glVertex3d(-0.5 + (1.0 * i / SIZEX), 0.0, EMIN(i));
       }
     }
   }
   if(field_type >= 2) { // display Hy
     glColor3d(BRIGHTCYAN);
     for(int i = 0; i < SIZEX; i++)
-      glVertex3d(-0.5 + ((0.5 + i) / SIZEX), IMP0 * space1d->c[i].h, 0.0);
+      glVertex3d(-0.5 + ((0.5 + i) / SIZEX), H(i), 0.0);
   }
   glEnd();
 
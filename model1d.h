@@ -33,10 +33,16 @@ class CModel1D : public CModel
 {
 public:
   CModel1D(GLWidget *parent = 0);
+  ~CModel1D();
 
+  void set_profile() const;
   void reset();
   void step();
   void draw() const;
+  size_t cells() const;
+  size_t snap_size() const;
+  void snap(float *v) const;
+  void checksum(CChecksum &c) const;
   void get_status(QString &s) const;
   void inc_field_type();
   void inc_cut_type();
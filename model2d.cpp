@@ -31,6 +31,14 @@ rugis@msu.edu
 #include "spaceEH2d.h"
 #include "abc2o2d.h"
 #include "tfsf2d.h"
+#include "shape.h"
+#include "voxelizer.h"
+#include "conformal2d.h"
+#include "pointcloud.h"
+#include "slice.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "golden.h"
 
 #include "model2d.h"
 
@@ -43,6 +51,7 @@ rugis@msu.edu
 
 #define PEC_DISK_00
 //#define PEC_DISK_01
+//#define PEC_DISK_CONFORMAL
 //#define PEC_BOX
 //#define PEC_LINE
 //#define PEC_SLIT
@@ -54,6 +63,12 @@ rugis@msu.edu
 
 #define ABC_SECOND_ORDER
 
+// display color & alpha mapping
+#define DECADES 2.3
+#define MAX 0.5
+#define ACUT 0.03
+#define ACUTM (1.0 / (MAX * ACUT))
+
 CModel2D::CModel2D(GLWidget *parent) : CModel(parent)
 {
   space2d = NULL;
@@ -61,7 +76,35 @@ CModel2D::CModel2D(GLWidget *parent) : CModel(parent)
   tfsf2d = NULL;  // tfsf's
 
   set_material(); // space & material
+  build_progress = 60;
   reset();        // space & material
+  cloud = new CPointCloud(SIZEX * SIZEY, DECADES, MAX, 0.8);
+  slice = new CSlice(SIZEX, SIZEY);
+  for(size_t j = 0; j < SIZEY; j++) {
+    for(size_t i = 0; i < SIZEX; i++) {
+      float *v = slice->vertex + 3 * (i + j * SIZEX);
+      v[0] = -0.5 + i / (SIZEX - 1.0);
+      v[1] = -0.5 + j / (SIZEY - 1.0);
+    }
+  }
+  set_profile();
+}
+
+CModel2D::~CModel2D()
+{
+  delete cloud;
+  delete slice;
+  delete abc2o2d;
+  delete tfsf2d;
+  delete space2d;
+}
+
+void CModel2D::set_profile() const
+{
+  profiler.set_cells(SIZEX * SIZEY, sizeof(Ccell2d));
+  profiler.set_flops(PHASE_H, 8.0); // per cell
+  profiler.set_flops(PHASE_E, 6.0);
+  profiler.set_flops(PHASE_STEP, 14.0);
 }
 
 // ***********************************************************************
@@ -115,32 +158,28 @@ void CModel2D::set_material()
   #define CR (0.15 * SIZEY)
   #define CX (0.5 * SIZEX)
   #define CY (0.5 * SIZEY)
-  for(int j = CY - CR; j < CY + CR; j++) {
-    for(int i = CX - CR; i < CX + CR; i++) {
-      int cr2 = CR * CR;
-      if( pow((i - CX), 2) + pow((j - CY), 2) <= cr2) {
-        int n = i + j * SIZEX;
-        space2d->c[n].cee = 0.0;
-        space2d->c[n].ceh = 0.0;
-      }
-    }
-  }
+  CCylinder disk(2, CX, CY, 0.0, CR, 1.0);
+  CVoxelizer voxelizer;
+  voxelizer.fill(space2d, &disk, CMaterial(1.0, 0.0, true));
 #endif
 
 #ifdef PEC_DISK_01
   #define CR (0.05 * SIZEX)
   #define CX (0.75 * SIZEX)
   #define CY (0.25 * SIZEY)
-  for(int j = CY - CR; j < CY + CR; j++) {
-    for(int i = CX - CR; i < CX + CR; i++) {
-      int cr2 = CR * CR;
-      if( pow((i - CX), 2) + pow((j - CY), 2) <= cr2) {
-        int n = i + j * SIZEX;
-        space2d->c[n].cee = 0.0;
-        space2d->c[n].ceh = 0.0;
-      }
-    }
-  }
+  CCylinder disk(2, CX, CY, 0.0, CR, 1.0);
+  CVoxelizer voxelizer;
+  voxelizer.fill(space2d, &disk, CMaterial(1.0, 0.0, true));
+#endif
+
+#ifdef PEC_DISK_CONFORMAL  // conformal (not staircased) PEC disk
+  #define CF_R (0.15 * SIZEY)
+  #define CF_X (0.5 * SIZEX)
+  #define CF_Y (0.5 * SIZEY)
+  #define CF_AMIN 0.5 // smallest cut face length fraction
+  CCylinder cf_disk(2, CF_X, CF_Y, 0.0, CF_R, 1.0);
+  CConformal2d conformal2d(space2d, &cf_disk, CF_AMIN);
+  conformal2d.reduce_dt();
 #endif
 
 #ifdef PEC_BOX
@@ -201,24 +240,37 @@ void CModel2D::set_material()
 // ***********************************************************************
 void CModel2D::step()
 {
+  PROFILE_BEGIN(PHASE_STEP);
+  PROFILE_BEGIN(PHASE_H);
   space2d->update_h(); // ***** update magnetic field *****
+  PROFILE_END(PHASE_H);
 
 #ifdef RICKER_PLANE
   #define WTS 50
+  PROFILE_BEGIN(PHASE_TFSF_A);
   tfsf2d->updateA();
+  PROFILE_END(PHASE_TFSF_A);
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceRicker(true, 0.3 / -IMP0, tfsf2d->inpm1, time_step, WTS);
   sourceRicker(true, 0.3, tfsf2d->inp, time_step + 1, WTS);
+  PROFILE_END(PHASE_SOURCE);
+  PROFILE_BEGIN(PHASE_TFSF_B);
   tfsf2d->updateB();
+  PROFILE_END(PHASE_TFSF_B);
 #endif
 
+  PROFILE_BEGIN(PHASE_E);
   space2d->update_e();  // ***** update electric field *****
+  PROFILE_END(PHASE_E);
 
 #ifdef RICKER_POINT
   #define WTS 200
   #define SRC_X (SIZEX / 4)
   #define SRC_Y (SIZEY / 2)
   #define SRC (SRC_X + SRC_Y * SIZEX)
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceRicker(false, 0.8, &(space2d->c[SRC].e), time_step, WTS);
+  PROFILE_END(PHASE_SOURCE);
 #endif
 
 #ifdef GAUSSIAN_POINT
@@ -242,6 +294,7 @@ void CModel2D::step()
   #define SRCA (SRC_X + 2 + (SRC_Y + 2) * SIZEX)
   #define SRCB (SRC_X + 3 + (SRC_Y + 2) * SIZEX)
 
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceGaussian(true, AMPE, &(space2d->c[SRC0].e), time_step, DTS, NWTSS);
   sourceGaussian(true, AMPE, &(space2d->c[SRC1].e), time_step, DTS, NWTSS);
   sourceGaussian(true, AMPE, &(space2d->c[SRC4].e), time_step, DTS, NWTSS);
@@ -251,18 +304,23 @@ void CModel2D::step()
 //  sourceGaussian(true, -AMPH, &(space2d->c[SRC4].h1), time_step, DTS, NWTSS);
 //  sourceGaussian(true, AMPH, &(space2d->c[SRC5].h1), time_step, DTS, NWTSS);
 //  sourceGaussian(true, AMPH, &(space2d->c[SRC5].h2), time_step, DTS, NWTSS);
+  PROFILE_END(PHASE_SOURCE);
 #endif
 
 #ifdef ABC_SECOND_ORDER
+  PROFILE_BEGIN(PHASE_ABC);
   abc2o2d->update();
+  PROFILE_END(PHASE_ABC);
 #endif
 
   time_step++;
+  PROFILE_END(PHASE_STEP);
 }
 
 void CModel2D::reset()
 {
   time_step = 0; // time step
+  dither_key++;
   space2d->reset();
   if(abc2o2d != NULL) abc2o2d->reset();
   if(tfsf2d != NULL) tfsf2d->reset();
@@ -306,81 +364,221 @@ void CModel2D::inc_field_type()
   if(++field_type > 4) field_type = 0;
 }
 
-void CModel2D::draw() const  // right handed space
+double CModel2D::field(size_t n) const // the displayed field value
 {
-  glBegin(GL_POINTS);
-  #define DECADES 2.3
-  #define MAX 0.5
-  #define ACUT 0.03
-  #define HSVH1 (-360.0 / (DECADES * log(10.0)))
-  #define HSVH2 1.0 / MAX
-  #define ACUTM (1.0 / (MAX * ACUT))
-  // display as Ez Hx Hy
-  HSV hsv;
-  RGB rgb;
-  size_t n;
-  hsv.s = 1.0;
-  hsv.v = 0.8;
-  if(cut_type < 2) {
-    double e, h1, h2, eh;
-    for(size_t i = 0; i < SIZEX; i++) {
-      for(size_t j = 0; j < SIZEY; j++) {
-        n = i + j * SIZEX;
-
-        if(field_type == 0) eh = space2d->c[n].e; // field type?
-        else if(field_type == 1) eh = IMP0 * space2d->c[n].h1;
-        else if(field_type == 2) eh = IMP0 * space2d->c[n].h2;
-        else if(field_type == 3) {
-          h1 = IMP0 * space2d->c[n].h1;
-          h2 = IMP0 * space2d->c[n].h2;
-          eh = sqrt(h1 * h1 + h2 * h2); // norm
-        }
-        else if(field_type == 4) {
-          e = space2d->c[n].e;
-          h1 = IMP0 * space2d->c[n].h1;
-          h2 = IMP0 * space2d->c[n].h2;
-          eh = sqrt(e * e + h1 * h1 + h2 * h2); // norm
-        }
+  double e, h1, h2, eh;
+  eh = 0.0;
+  if(field_type == 0) eh = space2d->c[n].e; // field type?
+  else if(field_type == 1) eh = IMP0 * space2d->c[n].h1;
+  else if(field_type == 2) eh = IMP0 * space2d->c[n].h2;
+  else if(field_type == 3) {
+    h1 = IMP0 * space2d->c[n].h1;
+    h2 = IMP0 * space2d->c[n].h2;
+    eh = sqrt(h1 * h1 + h2 * h2); // norm
+  }
+  else if(field_type == 4) {
+    e = space2d->c[n].e;
+    h1 = IMP0 * space2d->c[n].h1;
+    h2 = IMP0 * space2d->c[n].h2;
+    eh = sqrt(e * e + h1 * h1 + h2 * h2); // norm
+  }
+  return eh;
+}
+
+size_t CModel2D::cells() const
+{
+  return SIZEX * SIZEY;
+}
+
+size_t CModel2D::snap_size() const
+{
+  return SIZEX * SIZEY + 2 * SIZEX; // field, then line e & |h|
+}
+
+void CModel2D::snap(float *v) const
+{
+  PROFILE_BEGIN(PHASE_OUTPUT);
+  size_t s = SIZEX * SIZEY;
+  class CCopy : public CLoop { // displayed field values
+  public:
+    CCopy(const CModel2D *m, float *v) : m(m), v(v) {}
+    void run(long first, long last) {for(long n = first; n < last; n++) v[n] = m->field(n);}
+  private:
+    const CModel2D *m;
+    float *v;
+  } copy(this, v);
+  parallelFor(s, copy);
+  size_t l = (SIZEY / 2) * SIZEX;
+  for(size_t i = 0; i < SIZEX; i++) {
+    double h1 = IMP0 * space2d->c[i + l].h1;
+    double h2 = IMP0 * space2d->c[i + l].h2;
+    v[s + i] = space2d->c[i + l].e;
+    v[s + SIZEX + i] = sqrt(h1 * h1 + h2 * h2);
+  }
+  PROFILE_END(PHASE_OUTPUT);
+}
 
-        double ne = fabs(eh);
-        double alpha = ACUTM * ne;
-        if(alpha < 0.05) continue; // skip low alphas
-        hsv.h = HSVH1 * log(HSVH2 * ne);
-        if(hsv.h >= 360.0) hsv.h = 359.9;
-        HSVtoRGB(&hsv, &rgb);
-        glColor4d(rgb.r, rgb.g, rgb.b, alpha_fac * alpha);
-        double x = -0.5 + i / (SIZEX - 1.0);
-        double y = -0.5 + j / (SIZEY - 1.0);
-        double v = cut_type ? 0.0 : eh; // cut type surface or flat ?
-        if(dither)
-          if(p->run)
-            glVertex3d((randpm() / SIZEX) + x,
-                       (randpm() / SIZEY) + y,
-                       (randpm() / SIZEZ) + v);
-          else
-            glVertex3d((skip * space2d->d[n] / SIZEX) + x,
-                       (skip * space2d->d[2 * n] / SIZEY) + y,
-                       (skip * space2d->d[3 * n] / SIZEZ) + v);
-        else glVertex3d(x, y, v);
+void CModel2D::checksum(CChecksum &c) const
+{
+  for(size_t n = 0; n < SIZEX * SIZEY; n++) {
+    c.add(0, space2d->c[n].e);
+    c.add(1, IMP0 * space2d->c[n].h1);
+    c.add(1, IMP0 * space2d->c[n].h2);
+  }
+}
+
+// ***********************************************************************
+// model display
+// ***********************************************************************
+void CModel2D::draw_list() const // points to draw & vertices
+{
+  cloud->count = 0;
+  for(size_t i = 0; i < SIZEX; i++) {
+    for(size_t j = 0; j < SIZEY; j++) {
+      size_t n = i + j * SIZEX;
+      cloud->index[cloud->count++] = n;
+      double x = -0.5 + i / (SIZEX - 1.0);
+      double y = -0.5 + j / (SIZEY - 1.0);
+      double v = 0.0; // cut type surface: v is the field
+      if(dither) {
+        x += skip * ::dither(n, 0, cloud->dseed) / SIZEX;
+        y += skip * ::dither(n, 1, cloud->dseed) / SIZEY;
+        v += skip * ::dither(n, 2, cloud->dseed) / SIZEZ;
       }
+      cloud->vertex[3 * n] = x;
+      cloud->vertex[3 * n + 1] = y;
+      cloud->vertex[3 * n + 2] = v;
     }
   }
+  cloud->moved = true;
+}
+
+unsigned int CModel2D::view_serial() const // the displayed field values (color cache)
+{
+#ifdef SOLVER_THREAD
+  return view_id;
+#else
+  return (unsigned int)time_step;
+#endif
+}
+
+CPointCloud *CModel2D::points() const // display points for the current view
+{
+  if(cut_type > 1) return NULL; // line
+  int key = cut_type | (dither << 1) | (skip << 2);
+  unsigned int seed = dither_seed(view_serial());
+  if((key != cloud->key) || (dither && (seed != cloud->dseed))) { // view or jitter changed?
+    cloud->dseed = seed;
+    draw_list();
+    cloud->key = key;
+    cloud->ckey = -1; // vertices reset
+  }
+  int ckey = field_type;
+  if((ckey == cloud->ckey) && (view_serial() == cloud->cview) && (alpha_fac == cloud->calpha))
+    return cloud; // colors unchanged
+  class CColors : public CLoop { // all points
+  public:
+    CColors(const CModel2D *m) : m(m) {}
+    void run(long first, long last) {
+      for(long n = first; n < last; n++) {
+#ifdef SOLVER_THREAD
+        double eh = m->view[n];
+#else
+        double eh = m->field(n);
+#endif
+        double alpha = ACUTM * fabs(eh);
+        if(alpha < 0.05) alpha = 0.0; // skip low alphas
+        m->cloud->set_color(n, eh, m->alpha_fac * alpha);
+        if(m->cut_type == 0) { // surface?
+          double dv = m->dither ? m->skip * ::dither(n, 2, m->cloud->dseed) / SIZEZ : 0.0;
+          m->cloud->vertex[3 * n + 2] = eh + dv;
+        }
+      }
+    }
+  private:
+    const CModel2D *m;
+  } colors(this);
+  parallelFor(SIZEX * SIZEY, colors);
+  cloud->compact();
+  if(cut_type == 0) cloud->moved = true;
+  cloud->ckey = ckey;
+  cloud->cview = view_serial();
+  cloud->calpha = alpha_fac;
+  return cloud;
+}
+
+void CModel2D::draw_slice() const // surface: heightfield, flat: one quad
+{
+  bool surface = (cut_type == 0);
+  int ckey = field_type | (cut_type << 4);
+  if((ckey != slice->ckey) || (view_serial() != slice->cview) || (alpha_fac != slice->calpha)) {
+    class CTexels : public CLoop { // colors (& heights)
+    public:
+      CTexels(const CModel2D *m, bool surface) : m(m), surface(surface) {}
+      void run(long first, long last) {
+        for(long n = first; n < last; n++) {
+#ifdef SOLVER_THREAD
+          double eh = m->view[n];
+#else
+          double eh = m->field(n);
+#endif
+          double alpha = ACUTM * fabs(eh);
+          if(alpha < 0.05) alpha = 0.0; // skip low alphas
+          m->cloud->map_color(eh, m->alpha_fac * alpha, m->slice->color + 4 * n);
+          m->slice->vertex[3 * n + 2] = surface ? eh : 0.0;
+        }
+      }
+    private:
+      const CModel2D *m;
+      bool surface;
+    } texels(this, surface);
+    parallelFor(SIZEX * SIZEY, texels);
+    slice->changed = true;
+    slice->ckey = ckey;
+    slice->cview = view_serial();
+    slice->calpha = alpha_fac;
+  }
+  slice->draw(surface);
+}
+
+void CModel2D::draw() const  // right handed space
+{
+  // display as Ez Hx Hy
+  if(cut_type < 2) {
+#ifdef SLICE_TEXTURE
+    if((skip == 1) && !dither) draw_slice();
+    else points()->draw(); // thinned or dithered (per point positions)
+#else
+    points()->draw();
+#endif
+  }
   else {
+#ifndef SOLVER_THREAD
     size_t l = (SIZEY / 2) * SIZEX;
+#endif
+    glBegin(GL_POINTS);
     glColor3d(BRIGHTYELLOW);
     for(int i = 0; i < SIZEX; i++) {
+#ifdef SOLVER_THREAD
+      double e = view[SIZEX * SIZEY + i];
+#else
       double e = space2d->c[i + l].e;
+#endif
       glVertex3d(-0.5 + ((1.0 * i) / (SIZEX - 1)), 0.0, e);
     }
     glColor3d(BRIGHTCYAN);
     for(int i = 0; i < SIZEX; i++) {
+#ifdef SOLVER_THREAD
+      double h = view[SIZEX * SIZEY + SIZEX + i];
+#else
       double h1 = IMP0 * space2d->c[i + l].h1;
       double h2 = IMP0 * space2d->c[i + l].h2;
       double h = sqrt(h1 * h1 + h2 * h2);
+#endif
       glVertex3d(-0.5 + ((0.5 + i) / (SIZEX - 1)), h, 0.0);
     }
+    glEnd();
   }
-  glEnd();
 
   if(display_bbox) glCallList(bbox);
 }
@@ -28,15 +28,24 @@ rugis@msu.edu
 class CSpaceEH2d;
 class CAbc2o2d;
 class CTfsf2d;
+class CPointCloud;
+class CSlice;
 
 class CModel2D : public CModel
 {
 public:
   CModel2D(GLWidget *parent = 0);
+  ~CModel2D();
 
+  void set_profile() const;
   void reset();
   void step();
   void draw() const;
+  CPointCloud *points() const;
+  size_t cells() const;
+  size_t snap_size() const;
+  void snap(float *v) const;
+  void checksum(CChecksum &c) const;
   void get_status(QString &s) const;
   void inc_field_type();
   void inc_cut_type();
@@ -45,9 +54,15 @@ private:
   CSpaceEH2d *space2d; // 2d space
   CAbc2o2d *abc2o2d; // second order abc
   CTfsf2d *tfsf2d; // tfsf in 2d space
+  CPointCloud *cloud; // display points
+  CSlice *slice;      // display texture & heightfield
 
   size_t time_step;  // time step
   void set_material();
+  double field(size_t n) const;
+  unsigned int view_serial() const;
+  void draw_list() const;
+  void draw_slice() const;
 };
 
 #endif // MODEL2D_H
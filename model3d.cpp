@@ -31,6 +31,19 @@ rugis@msu.edu
 #include "spaceEH3d.h"
 #include "abc1o3d.h"
 #include "tfsf3d.h"
+#include "subgrid3d.h"
+#include "shape.h"
+#include "voxelizer.h"
+#include "mesh.h"
+#include "conformal3d.h"
+#include "pointcloud.h"
+#include "pyramid.h"
+#include "yeelattice.h"
+#include "slice.h"
+#include "isosurface.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "golden.h"
 
 #include "model3d.h"
 
@@ -41,6 +54,9 @@ rugis@msu.edu
 #define FREE_SPACE
 
 #define PEC_SPHERE_00
+//#define PEC_SPHERE_CONFORMAL
+//#define SUBGRID_SPHERE
+//#define MESH_OBJECTS
 //#define FIELD_PEC_SLIT
 
 #define RICKER_PLANE
@@ -50,15 +66,123 @@ rugis@msu.edu
 
 //#define ABC_FIRST_ORDER
 
+#if defined(PEC_SPHERE_00) || defined(PEC_SPHERE_CONFORMAL) || defined(SUBGRID_SPHERE) || defined(MESH_OBJECTS)
+  #define DISPLAY_OBJECTS // any of them: all drawn from one display list
+#endif
+
+#ifdef MESH_OBJECTS  // file, scale, position (grid cells), material
+static const struct {const char *file; double s, x, y, z; CMaterial m;} mesh_objects[] = {
+  {"object.stl", 1.0, 3.0 * SIZEX / 4.0, SIZEY / 2.0, SIZEZ / 2.0, CMaterial(1.0, 0.0, true)}
+};
+#endif
+
+// display color & alpha mapping
+#define DECADES 2.3
+#define MAX 0.5
+#define ACUT 0.03 // alpha-one cut-off factor
+#define ACUTM (1.0 / (MAX * ACUT)) // alpha cut multiplier
+
+// display level of detail (full view only)
+#define LOD_LEVELS 4       // pyramid levels above the grid
+#define LOD_BUDGET 250000  // most coarse level points
+#define LOD_REFINE 1.0     // refine blocks with at least this alpha
+
+// display isosurface (iso cut)
+#define ISO_LEVEL (0.1 * MAX) // |field| level at alpha factor one (Q/q: lower/raise)
+
+// NOTES:
+//  1) the level of detail pyramid keeps the block maximum of |field|, so a
+//     narrow wavefront inside a block still shows (skip striding can miss it)
+//  2) the coarse level is the finest one over budget or with blocks smaller
+//     than a pixel; blocks at or above LOD_REFINE are replaced by their
+//     children, down to the grid where the field is strong
+//  3) the pyramid is pooled from the displayed snapshot once per drawn frame
+//     (not per solver step), hidden tfsf boundary cells pool as zero
+//  4) the iso cut extracts the displayed field magnitude level surface once
+//     per drawn frame (as the pyramid), hidden tfsf boundary cells as zero
+
 CModel3D::CModel3D(GLWidget *parent) : CModel(parent)
 {
   space3d = NULL;
   abc1o3d = NULL;
   tfsf3d = NULL;
-  objects = NULL;
+  subgrid3d = NULL;
+  conformal3d = NULL;
+  objects = 0;
 
   set_material(); // space & material
+  build_progress = 60;
   reset();        // space & material
+  cloud = new CPointCloud(space3d->sXYZ, DECADES, MAX, 0.8);
+  yee = new CYeeLattice(SIZEX, SIZEY, SIZEZ);
+  slice_xz = new CSlice(SIZEX, SIZEZ); // y = SIZEY / 2
+  slice_xy = new CSlice(SIZEX, SIZEY); // z = SIZEZ / 2
+  for(size_t k = 0; k < SIZEZ; k++) {
+    for(size_t i = 0; i < SIZEX; i++) {
+      float *v = slice_xz->vertex + 3 * (i + k * SIZEX);
+      v[0] = -0.5 + i / (SIZEX - 1.0);
+      v[1] = -0.5 + (SIZEY / 2) / (SIZEY - 1.0);
+      v[2] = -0.5 + k / (SIZEZ - 1.0);
+    }
+  }
+  for(size_t j = 0; j < SIZEY; j++) {
+    for(size_t i = 0; i < SIZEX; i++) {
+      float *v = slice_xy->vertex + 3 * (i + j * SIZEX);
+      v[0] = -0.5 + i / (SIZEX - 1.0);
+      v[1] = -0.5 + j / (SIZEY - 1.0);
+    }
+  }
+  iso = new CIsosurface(SIZEX, SIZEY, SIZEZ);
+  set_profile();
+  build_progress = 80;
+
+  pyramid = new CPyramid(SIZEX, SIZEY, SIZEZ, LOD_LEVELS);
+  lod_off = new size_t[LOD_LEVELS + 2];
+  lod_off[0] = 0;
+  for(int l = 0; l <= LOD_LEVELS; l++) lod_off[l + 1] = lod_off[l] + pyramid->size(l);
+  lod = new CPointCloud(lod_off[LOD_LEVELS + 1], DECADES, MAX, 0.8);
+  for(int l = 0; l <= LOD_LEVELS; l++) { // block centre vertices
+    size_t b = size_t(1) << l;
+    for(size_t k = 0; k < pyramid->nz[l]; k++) {
+      double z = -0.5 + (k * b + (((k + 1) * b < SIZEZ) ? (k + 1) * b : SIZEZ) - 1) / (2.0 * (SIZEZ - 1.0));
+      for(size_t j = 0; j < pyramid->ny[l]; j++) {
+        double y = -0.5 + (j * b + (((j + 1) * b < SIZEY) ? (j + 1) * b : SIZEY) - 1) / (2.0 * (SIZEY - 1.0));
+        for(size_t i = 0; i < pyramid->nx[l]; i++) {
+          double x = -0.5 + (i * b + (((i + 1) * b < SIZEX) ? (i + 1) * b : SIZEX) - 1) / (2.0 * (SIZEX - 1.0));
+          float *v = lod->vertex + 3 * (lod_off[l] + i + j * pyramid->nx[l] + k * pyramid->nx[l] * pyramid->ny[l]);
+          v[0] = x; v[1] = y; v[2] = z;
+        }
+      }
+    }
+  }
+  lod->moved = true;
+}
+
+CModel3D::~CModel3D()
+{
+  if(objects != 0) glDeleteLists(objects, 1);
+  for(size_t i = 0; i < meshes.size(); i++) delete meshes[i];
+  delete lod;
+  delete[] lod_off;
+  delete pyramid;
+  delete cloud;
+  delete yee;
+  delete slice_xz;
+  delete slice_xy;
+  delete iso;
+  delete abc1o3d;
+  delete subgrid3d;
+  delete conformal3d;
+  delete tfsf3d;
+  delete space3d;
+}
+
+void CModel3D::set_profile() const
+{
+  profiler.set_cells(space3d->sXYZ, sizeof(Ccell3d));
+  profiler.set_flops(PHASE_H, 18.0); // per cell
+  profiler.set_flops(PHASE_E, 18.0);
+  profiler.set_flops(PHASE_STEP, 36.0);
 }
 // ***********************************************************************
 // model materials
@@ -66,6 +190,7 @@ CModel3D::CModel3D(GLWidget *parent) : CModel(parent)
 void CModel3D::set_material()
 {
   space3d = new CSpaceEH3d(SIZEX, SIZEY, SIZEZ);
+  build_progress = 10;
 
 #ifdef FREE_SPACE
   for(int i = 0; i < SIZEX * SIZEY * SIZEZ; i++) {
@@ -81,41 +206,52 @@ void CModel3D::set_material()
   #define CX (3 * SIZEX / 4)
   #define CY (SIZEY / 2)
   #define CZ (SIZEZ / 2)
-  for(int k = CZ - CR; k < CX + CR; k++) {
-    for(int j = CY - CR; j < CY + CR; j++) {
-      for(int i = CX - CR; i < CX + CR; i++) {
-        int cr2 = CR * CR;
-        if( pow((i - CX), 2) + pow((j - CY), 2) + pow((k - CZ), 2) <= cr2) {
-          int n = i + j * SIZEX + k * SIZEX * SIZEY;
-          space3d->c[n].cexe = 0.0;
-          space3d->c[n].cexh = 0.0;
-          space3d->c[n].ceye = 0.0;
-          space3d->c[n].ceyh = 0.0;
-          space3d->c[n].ceze = 0.0;
-          space3d->c[n].cezh = 0.0;
-        }
-      }
+  CSphere sphere(CX, CY, CZ, CR);
+  CVoxelizer voxelizer;
+  voxelizer.fill(space3d, &sphere, CMaterial(1.0, 0.0, true));
+#endif
+
+#ifdef PEC_SPHERE_CONFORMAL  // conformal (not staircased) PEC sphere
+  #define CF_R (SIZEX / 7.0)
+  #define CF_X (3.0 * SIZEX / 4.0)
+  #define CF_Y (SIZEY / 2.0)
+  #define CF_Z (SIZEZ / 2.0)
+  #define CF_AMIN 0.5 // smallest cut face area fraction
+  CSphere cf_sphere(CF_X, CF_Y, CF_Z, CF_R);
+  conformal3d = new CConformal3d(space3d, &cf_sphere, CF_AMIN);
+  conformal3d->reduce_dt();
+#endif
+
+#ifdef SUBGRID_SPHERE  // small PEC sphere resolved on a refined region
+  #define SG_RATIO 3         // refinement ratio
+  #define SG_R (SIZEX / 20)  // sphere radius (coarse cells)
+  #define SG_M 3             // region margin (coarse cells)
+  #define SG_X (3 * SIZEX / 4)
+  #define SG_Y (SIZEY / 2)
+  #define SG_Z (SIZEZ / 2)
+  subgrid3d = new CSubgrid3d(space3d,
+    SG_X - SG_R - SG_M, SG_Y - SG_R - SG_M, SG_Z - SG_R - SG_M,
+    SG_X + SG_R + SG_M, SG_Y + SG_R + SG_M, SG_Z + SG_R + SG_M, SG_RATIO);
+  CSpaceEH3d *fs = subgrid3d->f;
+  double fc = (SG_R + SG_M) * SG_RATIO;   // fine cells
+  CSphere sg_sphere(fc, fc, fc, SG_R * SG_RATIO);
+  CVoxelizer sg_voxelizer;
+  sg_voxelizer.fill(fs, &sg_sphere, CMaterial(1.0, 0.0, true));
+#endif
+
+#ifdef MESH_OBJECTS  // triangle meshes (STL, OBJ) in grid cells, each with a material
+  CVoxelizer ms_voxelizer;
+  for(size_t i = 0; i < sizeof(mesh_objects) / sizeof(mesh_objects[0]); i++) {
+    CMesh *mesh = new CMesh;
+    if(!mesh->load(mesh_objects[i].file, mesh_objects[i].s,
+                   mesh_objects[i].x, mesh_objects[i].y, mesh_objects[i].z)) {
+      error = QString("Can't load mesh file (or not closed): ") + mesh_objects[i].file; // maybe off the GUI thread
+      delete mesh;
+      mesh = NULL; // left out, the model is still complete
     }
+    else ms_voxelizer.fill(space3d, mesh, mesh_objects[i].m);
+    meshes.push_back(mesh);
   }
-
-  GLfloat mat_diffuse[] = {0.4, 0.4, 0.4, 1.0};
-  GLfloat mat_specular[] = {1.0, 1.0, 1.0, 1.0};
-  GLfloat mat_shininess[] = {1.0};
-  objects = glGenLists(1);
-  float s = (float(CR) - 0.5) / SIZEX;
-  float tX = 0.25;
-  float tY = 0.0;
-  float tZ = 0.0;
-  glNewList(objects, GL_COMPILE);
-    glPushMatrix();
-    glTranslatef(tX, tY, tZ);
-    glScalef(s, s, s);
-    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, mat_diffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, mat_specular);
-    glMaterialfv(GL_FRONT, GL_SHININESS, mat_shininess);
-    icosphere(5);
-    glPopMatrix();
-  glEndList();
 #endif
 
   // set tfsf and abc's after material initialization!!!
@@ -137,32 +273,143 @@ void CModel3D::set_material()
 #endif
 }
 
+// ***********************************************************************
+// model display objects
+// ***********************************************************************
+void CModel3D::init_gl()
+{
+  CModel::init_gl();
+
+#ifdef DISPLAY_OBJECTS
+  objects = glGenLists(1); // all enabled objects, one list
+  glNewList(objects, GL_COMPILE);
+#endif
+
+#ifdef PEC_SPHERE_00
+  GLfloat mat_diffuse[] = {0.4, 0.4, 0.4, 1.0};
+  GLfloat mat_specular[] = {1.0, 1.0, 1.0, 1.0};
+  GLfloat mat_shininess[] = {1.0};
+  float s = (float(CR) - 0.5) / SIZEX;
+  float tX = 0.25;
+  float tY = 0.0;
+  float tZ = 0.0;
+  glPushMatrix();
+  glTranslatef(tX, tY, tZ);
+  glScalef(s, s, s);
+  glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, mat_diffuse);
+  glMaterialfv(GL_FRONT, GL_SPECULAR, mat_specular);
+  glMaterialfv(GL_FRONT, GL_SHININESS, mat_shininess);
+  icosphere(5);
+  glPopMatrix();
+#endif
+
+#ifdef PEC_SPHERE_CONFORMAL
+  GLfloat cf_diffuse[] = {0.4, 0.4, 0.4, 1.0};
+  GLfloat cf_specular[] = {1.0, 1.0, 1.0, 1.0};
+  GLfloat cf_shininess[] = {1.0};
+  float cfs = CF_R / (SIZEX - 1);
+  glPushMatrix();
+  glTranslatef(CF_X / (SIZEX - 1) - 0.5, CF_Y / (SIZEY - 1) - 0.5, CF_Z / (SIZEZ - 1) - 0.5);
+  glScalef(cfs, cfs, cfs);
+  glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, cf_diffuse);
+  glMaterialfv(GL_FRONT, GL_SPECULAR, cf_specular);
+  glMaterialfv(GL_FRONT, GL_SHININESS, cf_shininess);
+  icosphere(5);
+  glPopMatrix();
+#endif
+
+#ifdef SUBGRID_SPHERE
+  GLfloat sg_diffuse[] = {0.4, 0.4, 0.4, 1.0};
+  GLfloat sg_specular[] = {1.0, 1.0, 1.0, 1.0};
+  GLfloat sg_shininess[] = {1.0};
+  float sgs = float(SG_R) / SIZEX;
+  glPushMatrix();
+  glTranslatef(0.25, 0.0, 0.0);
+  glScalef(sgs, sgs, sgs);
+  glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, sg_diffuse);
+  glMaterialfv(GL_FRONT, GL_SPECULAR, sg_specular);
+  glMaterialfv(GL_FRONT, GL_SHININESS, sg_shininess);
+  icosphere(5);
+  glPopMatrix();
+#endif
+
+#ifdef MESH_OBJECTS
+  GLfloat pec_diffuse[] = {0.4, 0.4, 0.4, 1.0};
+  GLfloat die_diffuse[] = {0.3, 0.4, 0.6, 1.0};
+  GLfloat ms_specular[] = {1.0, 1.0, 1.0, 1.0};
+  GLfloat ms_shininess[] = {1.0};
+  glPushMatrix();
+  glPushAttrib(GL_ENABLE_BIT);
+  glEnable(GL_NORMALIZE);
+  glTranslatef(-0.5, -0.5, -0.5);
+  glScalef(1.0 / (SIZEX - 1), 1.0 / (SIZEY - 1), 1.0 / (SIZEZ - 1));
+  glMaterialfv(GL_FRONT, GL_SPECULAR, ms_specular);
+  glMaterialfv(GL_FRONT, GL_SHININESS, ms_shininess);
+  for(size_t i = 0; i < meshes.size(); i++) { // as loaded by set_material()
+    if(meshes[i] == NULL) continue;
+    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, mesh_objects[i].m.pec ? pec_diffuse : die_diffuse);
+    meshes[i]->draw();
+  }
+  glPopAttrib();
+  glPopMatrix();
+#endif
+
+#ifdef DISPLAY_OBJECTS
+  glEndList();
+#endif
+}
+
 // ***********************************************************************
 // model field step
 // ***********************************************************************
 void CModel3D::step()
 {
+  PROFILE_BEGIN(PHASE_STEP);
+  PROFILE_BEGIN(PHASE_H);
   space3d->update_h(); //  ***** update magnetic field *****
+  PROFILE_END(PHASE_H);
+
+#ifdef PEC_SPHERE_CONFORMAL
+  conformal3d->update_h(); // cut cell faces
+#endif
 
 #ifdef RICKER_PLANE
   #define WTS 100
+  PROFILE_BEGIN(PHASE_TFSF_A);
   tfsf3d->updateA();
+  PROFILE_END(PHASE_TFSF_A);
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceRicker(true, 0.3 / -IMP0, tfsf3d->inpm1, time_step, WTS);
   sourceRicker(true, 0.3, tfsf3d->inp, time_step + 1, WTS);
+  PROFILE_END(PHASE_SOURCE);
+  PROFILE_BEGIN(PHASE_TFSF_B);
   tfsf3d->updateB();
+  PROFILE_END(PHASE_TFSF_B);
 #endif
 
 #ifdef GAUSSIAN_PLANE
   #define WTS 10
   #define DTS (WTS * 4) // delay time steps
   #define NWTSS (-1.0 * pow(WTS, 2)) // negative ((width time steps) squared)
+  PROFILE_BEGIN(PHASE_TFSF_A);
   tfsf3d->updateA();
+  PROFILE_END(PHASE_TFSF_A);
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceGaussian(true, 0.3 / -IMP0, tfsf3d->inpm1, time_step, DTS, NWTSS);
   sourceGaussian(true, 0.3, tfsf3d->inp, time_step + 1, DTS, NWTSS);
+  PROFILE_END(PHASE_SOURCE);
+  PROFILE_BEGIN(PHASE_TFSF_B);
   tfsf3d->updateB();
+  PROFILE_END(PHASE_TFSF_B);
+#endif
+
+#ifdef SUBGRID_SPHERE
+  subgrid3d->store(); // coarse e-fields before update
 #endif
 
+  PROFILE_BEGIN(PHASE_E);
   space3d->update_e();  // ***** update electric field *****
+  PROFILE_END(PHASE_E);
 
 #ifdef RICKER_POINT
   #define WTS 200
@@ -170,7 +417,9 @@ void CModel3D::step()
   #define SRC_Y (SIZEY / 2)
   #define SRC_Z (SIZEZ / 2)
   #define SRC (SRC_X + SRC_Y * SIZEX + SRC_Z * SIZEX * SIZEY)
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceRicker(false, 10.0, &(space3d->c[SRC].ez), time_step, WTS);
+  PROFILE_END(PHASE_SOURCE);
 #endif
 
 #ifdef GAUSSIAN_POINT
@@ -181,11 +430,19 @@ void CModel3D::step()
   #define SRC_Y (SIZEY / 2)
   #define SRC_Z (SIZEZ / 2)
   #define SRC (SRC_X + SRC_Y * SIZEX + SRC_Z * SIZEX * SIZEY)
+  PROFILE_BEGIN(PHASE_SOURCE);
   sourceGaussian(false, 10.0, &(space3d->c[SRC].ez), time_step, DTS, NWTSS);
+  PROFILE_END(PHASE_SOURCE);
+#endif
+
+#ifdef SUBGRID_SPHERE
+  subgrid3d->update(); // fine sub-steps & coarse restriction
 #endif
 
 #ifdef ABC_FIRST_ORDER
+  PROFILE_BEGIN(PHASE_ABC);
   abc1o3d->update_e();
+  PROFILE_END(PHASE_ABC);
 #endif
 
 #ifdef FIELD_PEC_SLIT
@@ -204,20 +461,23 @@ void CModel3D::step()
 #endif
 
   time_step++;
+  PROFILE_END(PHASE_STEP);
 }
 
 void CModel3D::reset()
 {
   time_step = 0; // time step
   alpha_fac = 1.0;
+  dither_key++;
   space3d->reset();
   if(abc1o3d != NULL) abc1o3d->reset();
   if(tfsf3d != NULL) tfsf3d->reset();
+  if(subgrid3d != NULL) subgrid3d->reset();
 }
 
 void CModel3D::inc_cut_type()
 {
-  if(++cut_type > 4) cut_type = 0;
+  if(++cut_type > 5) cut_type = 0;
 }
 
 void CModel3D::inc_field_type()
@@ -225,150 +485,539 @@ void CModel3D::inc_field_type()
   if(++field_type > 8) field_type = 0;
 }
 
-void CModel3D::draw() const  // right handed space
+double CModel3D::field(size_t n) const // the displayed field value
 {
-  if(objects != 0) glCallList(objects);
+  double eh, ex, ey, ez, hx, hy, hz;
+  eh = 0.0; // play it safe
+
+  if(field_type == 1) eh = space3d->c[n].ex; // field type?
+  else if(field_type == 2) eh = space3d->c[n].ey;
+  else if(field_type == 3) eh = space3d->c[n].ez;
+  else if(field_type == 0) {
+    ex = space3d->c[n].ex;
+    ey = space3d->c[n].ey;
+    ez = space3d->c[n].ez;
+    eh = sqrt(ex * ex + ey * ey + ez * ez); // norm
+  }
+  else if(field_type == 5) eh = IMP0 * space3d->c[n].hx;
+  else if(field_type == 6) eh = IMP0 * space3d->c[n].hy;
+  else if(field_type == 7) eh = IMP0 * space3d->c[n].hz;
+  else if(field_type == 5) {
+    hx = IMP0 * space3d->c[n].hx;
+    hy = IMP0 * space3d->c[n].hy;
+    hz = IMP0 * space3d->c[n].hz;
+    eh = sqrt(hx * hx + hy * hy + hz * hz); // norm
+  }
+  else if(field_type == 8) {
+    ex = space3d->c[n].hx;
+    ey = space3d->c[n].hy;
+    ez = space3d->c[n].hz;
+    hx = IMP0 * space3d->c[n].hx;
+    hy = IMP0 * space3d->c[n].hy;
+    hz = IMP0 * space3d->c[n].hz;
+    eh = sqrt(ex * ex + ey * ey + ez * ez + hx * hx + hy * hy + hz * hz); // norm
+  }
+  return eh;
+}
+
+size_t CModel3D::cells() const
+{
+  return space3d->sXYZ;
+}
 
-  glBegin(GL_POINTS);
-  #define DECADES 2.3
-  #define MAX 0.5
-  #define HSVH1 (-360.0 / (DECADES * log(10.0)))
-  #define HSVH2 1.0 / MAX
-  #define ACUT 0.03 // alpha-one cut-off factor
-  #define ACUTM (1.0 / (MAX * ACUT)) // alpha cut multiplier
-  HSV hsv;
-  RGB rgb;
+size_t CModel3D::snap_size() const
+{
+  return space3d->sXYZ;
+}
+
+void CModel3D::snap(float *v) const
+{
+  PROFILE_BEGIN(PHASE_OUTPUT);
+  class CCopy : public CLoop { // displayed field values
+  public:
+    CCopy(const CModel3D *m, float *v) : m(m), v(v) {}
+    void run(long first, long last) {for(long n = first; n < last; n++) v[n] = m->field(n);}
+  private:
+    const CModel3D *m;
+    float *v;
+  } copy(this, v);
+  parallelFor(space3d->sXYZ, copy);
+  PROFILE_END(PHASE_OUTPUT);
+}
+
+void CModel3D::checksum(CChecksum &c) const
+{
+  for(size_t n = 0; n < space3d->sXYZ; n++) {
+    const Ccell3d *cell = &(space3d->c[n]);
+    c.add(0, cell->ex);
+    c.add(0, cell->ey);
+    c.add(0, cell->ez);
+    c.add(1, IMP0 * cell->hx);
+    c.add(1, IMP0 * cell->hy);
+    c.add(1, IMP0 * cell->hz);
+  }
+}
+
+// ***********************************************************************
+// model display
+// ***********************************************************************
+void CModel3D::draw_list() const // points to draw, far to near & vertices
+{
+  class CPlanes : public CLoop { // count (or list) points per plane (kk), far to near
+  public:
+    CPlanes(const CModel3D *m, size_t *start) : m(m), c(m->cloud), start(start), copy(false) {
+      if(m->face == 3) {
+        maxkk = SIZEZ;
+        maxjj = SIZEY;
+        maxii = SIZEX;
+      }
+      else if(m->face == 2) {
+        maxkk = SIZEY;
+        maxjj = SIZEX;
+        maxii = SIZEZ;
+      }
+      else{
+        maxkk = SIZEX;
+        maxjj = SIZEZ;
+        maxii = SIZEY;
+      }
+      sxmax = symax = szmax = smin = 0;
+      if(!m->display_boundary && (m->tfsf3d != NULL)) {
+        sxmax = SIZEX - m->tfsf3d->sb;
+        symax = SIZEY - m->tfsf3d->sb;
+        szmax = SIZEZ - m->tfsf3d->sb;
+        smin = m->tfsf3d->sb;
+      }
+    }
+    long planes() const { return (maxkk + m->skip - 1) / m->skip; }
+    void run(long first, long last) {
+      const int face = m->face, cut_type = m->cut_type, skip = m->skip;
+      const bool xp = m->xp, yp = m->yp, zp = m->zp;
+      long i = 0;
+      long j = 0;
+      long k = 0;
+      for(long p = first; p < last; p++) {
+        long kk = p * skip;
+        size_t count = copy ? start[p] : 0;
+        if(face == 3)          k = zp ? kk : maxkk - 1 - kk;
+        else if(face == 2)     j = yp ? kk : maxkk - 1 - kk;
+        else                   i = xp ? kk : maxkk - 1 - kk;
+        for(long jj = 0; jj < maxjj; jj += skip) {
+          if(face == 3)          j = yp ? jj : maxjj - 1 - jj;
+          else if(face == 2)     i = xp ? jj : maxjj - 1 - jj;
+          else                   k = zp ? jj : maxjj - 1 - jj;
+          for(long ii = 0; ii < maxii; ii += skip) {
+            if(face == 3)          i = xp ? ii : maxii - 1 - ii;
+            else if(face == 2)     k = zp ? ii : maxii - 1 - ii;
+            else                   j = yp ? ii : maxii - 1 - ii;
+
+            if((cut_type == 1) && j < (SIZEY / 2)) continue; // display half: skip
+            if((cut_type == 2) && j != (SIZEY / 2)) continue; // display slice: skip
+            if((cut_type == 3) && ( k != SIZEZ / 2)) continue; // display surface: skip
+            if((cut_type == 4) && (j != (SIZEY / 2) || k != SIZEZ / 2)) continue; // display line: skip
+            if(sxmax != 0) if(i >= sxmax) continue;
+            if(symax != 0) if(j >= symax) continue;
+            if(szmax != 0) if(k >= szmax) continue;
+            if(smin != 0) if((i < smin) || (j < smin) || (k < smin)) continue;
+
+            if(!copy) {
+              count++;
+              continue;
+            }
+            size_t n = i + j * SIZEX + k * SIZEX * SIZEY;
+            c->index[count++] = n;
+            double x = -0.5 + i / (SIZEX - 1.0);
+            double y = -0.5 + j / (SIZEY - 1.0);
+            double z = ((cut_type == 3) || (cut_type == 4)) ? 0.0 : -0.5 + k / (SIZEZ - 1.0); // surface or line: z is the field
+            if(m->dither && (cut_type != 4)) {
+              x += skip * ::dither(n, 0, c->dseed) / SIZEX;
+              y += skip * ::dither(n, 1, c->dseed) / SIZEY;
+              z += skip * ::dither(n, 2, c->dseed) / SIZEZ;
+            }
+            c->vertex[3 * n] = x;
+            c->vertex[3 * n + 1] = y;
+            c->vertex[3 * n + 2] = z;
+          }
+        }
+        if(!copy) start[p + 1] = count;
+      }
+    }
+    const CModel3D *m;
+    CPointCloud *c;
+    size_t *start;
+    bool copy;
+    long maxii, maxjj, maxkk;
+    long sxmax, symax, szmax, smin;
+  };
+
+  std::vector<size_t> start(qMax(SIZEX, qMax(SIZEY, SIZEZ)) + 1);
+  start[0] = 0;
+  CPlanes planes(this, &start[0]);
+  long np = planes.planes();
+  parallelFor(np, planes);
+  for(long p = 0; p < np; p++) start[p + 1] += start[p]; // plane offsets
+  planes.copy = true;
+  parallelFor(np, planes);
+  cloud->count = start[np];
+  cloud->moved = true;
+}
+
+int CModel3D::lod_level() const // coarse display level (0: the grid)
+{
+  if((skip != 1) || (cut_type != 0)) return 0;
+  double cpp = (zoom > 0.0) ? qMax(SIZEX, qMax(SIZEY, SIZEZ)) / zoom : 0.0; // cells per pixel
+  int l = 0;
+  while((l < LOD_LEVELS) && ((double(size_t(1) << (l + 1)) <= cpp) || (pyramid->size(l) > LOD_BUDGET))) l++;
+  return l;
+}
+
+void CModel3D::lod_list(int l) const // level l blocks, far to near
+{
   long ii, jj, kk, maxii, maxjj, maxkk;
-  size_t n;
-  double eh, ex, ey, ez, hx, hy, hz;
-  double x, y, z;
-  hsv.s = 1.0;
-  hsv.v = 0.8;
+  size_t nx = pyramid->nx[l];
+  size_t ny = pyramid->ny[l];
+  size_t nz = pyramid->nz[l];
 
   if(face == 3) {
-    maxkk = SIZEZ;
-    maxjj = SIZEY;
-    maxii = SIZEX;
+    maxkk = nz;
+    maxjj = ny;
+    maxii = nx;
   }
   else if(face == 2) {
-    maxkk = SIZEY;
-    maxjj = SIZEX;
-    maxii = SIZEZ;
+    maxkk = ny;
+    maxjj = nx;
+    maxii = nz;
   }
   else{
-    maxkk = SIZEX;
-    maxjj = SIZEZ;
-    maxii = SIZEY;
+    maxkk = nx;
+    maxjj = nz;
+    maxii = ny;
   }
 
   long i = 0;
   long j = 0;
   long k = 0;
-  long sxmax, symax, szmax, smin;
-  sxmax = symax = szmax = smin = 0;
-  if(!display_boundary && (tfsf3d != NULL)) {
-    sxmax = SIZEX - tfsf3d->sb;
-    symax = SIZEY - tfsf3d->sb;
-    szmax = SIZEZ - tfsf3d->sb;
-    smin = tfsf3d->sb;
-  }
-  for(kk = 0; kk < maxkk; kk += skip) {
+  lod->count = 0;
+  for(kk = 0; kk < maxkk; kk++) {
     if(face == 3)          k = zp ? kk : maxkk - 1 - kk;
     else if(face == 2)     j = yp ? kk : maxkk - 1 - kk;
     else                   i = xp ? kk : maxkk - 1 - kk;
-    for(jj = 0; jj < maxjj; jj += skip) {
+    for(jj = 0; jj < maxjj; jj++) {
       if(face == 3)          j = yp ? jj : maxjj - 1 - jj;
       else if(face == 2)     i = xp ? jj : maxjj - 1 - jj;
       else                   k = zp ? jj : maxjj - 1 - jj;
-      for(ii = 0; ii < maxii; ii += skip) {
+      for(ii = 0; ii < maxii; ii++) {
         if(face == 3)          i = xp ? ii : maxii - 1 - ii;
         else if(face == 2)     k = zp ? ii : maxii - 1 - ii;
         else                   j = yp ? ii : maxii - 1 - ii;
+        lod->index[lod->count++] = lod_off[l] + i + j * nx + k * nx * ny;
+      }
+    }
+  }
+}
 
-        if((cut_type == 1) && j < (SIZEY / 2)) continue; // display half: skip
-        if((cut_type == 2) && j != (SIZEY / 2)) continue; // display slice: skip
-        if((cut_type == 3) && ( k != SIZEZ / 2)) continue; // display surface: skip
-        if((cut_type == 4) && (j != (SIZEY / 2) || k != SIZEZ / 2)) continue; // display line: skip
-        if(sxmax != 0) if(i >= sxmax) continue;
-        if(symax != 0) if(j >= symax) continue;
-        if(szmax != 0) if(k >= szmax) continue;
-        if(smin != 0) if((i < smin) || (j < smin) || (k < smin)) continue;
-
-        n = i + j * SIZEX + k * SIZEX * SIZEY;
-        eh = 0.0; // play it safe
-
-        if(field_type == 1) eh = space3d->c[n].ex; // field type?
-        else if(field_type == 2) eh = space3d->c[n].ey;
-        else if(field_type == 3) eh = space3d->c[n].ez;
-        else if(field_type == 0) {
-          ex = space3d->c[n].ex;
-          ey = space3d->c[n].ey;
-          ez = space3d->c[n].ez;
-          eh = sqrt(ex * ex + ey * ey + ez * ez); // norm
+// children of a refined level l block into the compacted list
+// (each axis far to near, not the full face order: eight points)
+void CModel3D::lod_refine(int l, size_t i, size_t j, size_t k, size_t &v) const
+{
+  int c = l - 1;
+  size_t nx = pyramid->nx[c];
+  size_t ny = pyramid->ny[c];
+  size_t nz = pyramid->nz[c];
+  const float *f = pyramid->level[c];
+  for(int dk = 0; dk < 2; dk++) {
+    size_t ck = 2 * k + (zp ? dk : 1 - dk);
+    if(ck >= nz) continue;
+    for(int dj = 0; dj < 2; dj++) {
+      size_t cj = 2 * j + (yp ? dj : 1 - dj);
+      if(cj >= ny) continue;
+      for(int di = 0; di < 2; di++) {
+        size_t ci = 2 * i + (xp ? di : 1 - di);
+        if(ci >= nx) continue;
+        size_t n = ci + cj * nx + ck * nx * ny;
+        double alpha = ACUTM * f[n];
+        if((c > 0) && (alpha >= LOD_REFINE)) lod_refine(c, ci, cj, ck, v);
+        else if(alpha >= 0.05) {
+          lod->set_color(lod_off[c] + n, f[n], alpha_fac * alpha);
+          if(lod->color[4 * (lod_off[c] + n) + 3] != 0) lod->list[v++] = lod_off[c] + n;
         }
-        else if(field_type == 5) eh = IMP0 * space3d->c[n].hx;
-        else if(field_type == 6) eh = IMP0 * space3d->c[n].hy;
-        else if(field_type == 7) eh = IMP0 * space3d->c[n].hz;
-        else if(field_type == 5) {
-          hx = IMP0 * space3d->c[n].hx;
-          hy = IMP0 * space3d->c[n].hy;
-          hz = IMP0 * space3d->c[n].hz;
-          eh = sqrt(hx * hx + hy * hy + hz * hz); // norm
+      }
+    }
+  }
+}
+
+CPointCloud *CModel3D::lod_points(int l) const // display points, level of detail
+{
+  int key = face | (xp << 2) | (yp << 3) | (zp << 4) | (l << 5);
+  if(key != lod->key) { // view changed?
+    lod_list(l);
+    lod->key = key;
+  }
+
+  int ckey = display_boundary | (field_type << 1);
+  if((ckey != lod->ckey) || (view_serial() != lod->cview)) { // pyramid of new fields
+    magnitude(pyramid->level[0]);
+    pyramid->build();
+    lod->ckey = ckey;
+    lod->cview = view_serial();
+  }
+
+  class CColors : public CLoop { // coarse level colors
+  public:
+    CColors(const CModel3D *m, int l) : m(m), l(l) {}
+    void run(long first, long last) {
+      const float *c = m->pyramid->level[l];
+      size_t off = m->lod_off[l];
+      for(long i = first; i < last; i++) {
+        GLuint b = m->lod->index[i];
+        double alpha = ACUTM * c[b - off];
+        if((alpha < 0.05) || ((l > 0) && (alpha >= LOD_REFINE))) alpha = 0.0; // skip or refine
+        m->lod->set_color(b, c[b - off], m->alpha_fac * alpha);
+      }
+    }
+  private:
+    const CModel3D *m;
+    int l;
+  } colors(this, l);
+  parallelFor(lod->count, colors);
+
+  const float *c = pyramid->level[l];
+  size_t off = lod_off[l];
+  const GLuint *index = lod->index;
+  long count = lod->count;
+  size_t nx = pyramid->nx[l];
+  size_t ny = pyramid->ny[l];
+  size_t v = 0;
+  for(long m = 0; m < count; m++) { // compact, refined blocks in place
+    size_t n = index[m] - off;
+    if((l > 0) && (ACUTM * c[n] >= LOD_REFINE))
+      lod_refine(l, n % nx, (n / nx) % ny, n / (nx * ny), v);
+    else if(lod->color[4 * index[m] + 3] != 0) lod->list[v++] = index[m];
+  }
+  lod->visible = v;
+  lod->colored = true;
+  return lod;
+}
+
+void CModel3D::magnitude(float *f) const // |displayed field|, hidden tfsf boundary as zero
+{
+  class CMagnitude : public CLoop { // planes (k)
+  public:
+    CMagnitude(const CModel3D *m, float *f) : m(m), f(f) {
+      smax = 0;
+      if(!m->display_boundary && (m->tfsf3d != NULL)) smax = m->tfsf3d->sb;
+    }
+    void run(long first, long last) {
+      for(long k = first; k < last; k++) {
+        for(long j = 0; j < SIZEY; j++) {
+          for(long i = 0; i < SIZEX; i++) {
+            size_t n = i + j * SIZEX + k * SIZEX * SIZEY;
+            if((smax != 0) && ((i < smax) || (j < smax) || (k < smax) ||
+               (i >= SIZEX - smax) || (j >= SIZEY - smax) || (k >= SIZEZ - smax))) f[n] = 0.0;
+#ifdef SOLVER_THREAD
+            else f[n] = fabs(m->view[n]);
+#else
+            else f[n] = fabs(m->field(n));
+#endif
+          }
         }
-        else if(field_type == 8) {
-          ex = space3d->c[n].hx;
-          ey = space3d->c[n].hy;
-          ez = space3d->c[n].hz;
-          hx = IMP0 * space3d->c[n].hx;
-          hy = IMP0 * space3d->c[n].hy;
-          hz = IMP0 * space3d->c[n].hz;
-          eh = sqrt(ex * ex + ey * ey + ez * ez + hx * hx + hy * hy + hz * hz); // norm
+      }
+    }
+  private:
+    const CModel3D *m;
+    float *f;
+    long smax;
+  } mag(this, f);
+  parallelFor(SIZEZ, mag);
+}
+
+unsigned int CModel3D::view_serial() const // the displayed field values (color cache)
+{
+#ifdef SOLVER_THREAD
+  return view_id;
+#else
+  return (unsigned int)time_step;
+#endif
+}
+
+CPointCloud *CModel3D::points() const // display points for the current view
+{
+  int l = lod_level();
+  if(l > 0) return lod_points(l);
+
+  int key = face | (xp << 2) | (yp << 3) | (zp << 4) | (cut_type << 5)
+    | (display_boundary << 8) | (dither << 9) | (skip << 10);
+  unsigned int seed = dither_seed(view_serial());
+  bool reorder = (key != cloud->key) || (dither && (seed != cloud->dseed));
+  if(reorder) { // view or jitter changed?
+    cloud->dseed = seed;
+    draw_list();
+    cloud->key = key;
+    if((cut_type == 3) || (cut_type == 4)) cloud->ckey = -1; // field z reset
+  }
+  int ckey = cut_type | (display_boundary << 3) | (dither << 4) | (field_type << 5) | (skip << 9);
+  if((ckey == cloud->ckey) && (view_serial() == cloud->cview) && (alpha_fac == cloud->calpha)) {
+    if(reorder) cloud->compact(); // same colors, new depth order
+    return cloud;
+  }
+  const GLuint *index = cloud->index;
+  long count = cloud->count;
+  if(cut_type == 4) { // line?
+    for(long m = 0; m < count; m++) {
+      size_t n = index[m];
+#ifdef SOLVER_THREAD
+      cloud->vertex[3 * n + 2] = view[n];
+#else
+      cloud->vertex[3 * n + 2] = field(n);
+#endif
+      cloud->set_color(n, 0, 0, 0, 255);
+    }
+  }
+  else {
+    class CColors : public CLoop { // listed points
+    public:
+      CColors(const CModel3D *m) : m(m) {}
+      void run(long first, long last) {
+        bool surface = (m->cut_type == 3);
+        double acut = surface ? 0.0 : 0.05; // skip low alphas (not surface)
+        for(long i = first; i < last; i++) {
+          size_t n = m->cloud->index[i];
+#ifdef SOLVER_THREAD
+          double eh = m->view[n];
+#else
+          double eh = m->field(n);
+#endif
+          double alpha = ACUTM * fabs(eh);
+          if(alpha < acut) alpha = 0.0;
+          m->cloud->set_color(n, eh, m->alpha_fac * alpha);
+          if(surface) {
+            double dz = m->dither ? m->skip * ::dither(n, 2, m->cloud->dseed) / SIZEZ : 0.0;
+            m->cloud->vertex[3 * n + 2] = eh + dz;
+          }
         }
+      }
+    private:
+      const CModel3D *m;
+    } colors(this);
+    parallelFor(count, colors);
+  }
+  cloud->compact();
+  if((cut_type == 3) || (cut_type == 4)) cloud->moved = true;
+  cloud->ckey = ckey;
+  cloud->cview = view_serial();
+  cloud->calpha = alpha_fac;
+  return cloud;
+}
 
-        double alpha = ACUTM * fabs(eh);
-        if((cut_type < 3) && (alpha < 0.05)) continue; // skip low alphas
-        if(cut_type == 4) glColor4d(BLACK, 1.0); // line?
-        else {
-          hsv.h = HSVH1 * log(HSVH2 * fabs(eh)); // set color
-          if(hsv.h >= 360.0) hsv.h = 359.9; // clamp at max
-          HSVtoRGB(&hsv, &rgb);
-          glColor4d(rgb.r, rgb.g, rgb.b, alpha_fac * alpha);
+void CModel3D::draw_slice() const // slice: one quad, surface: heightfield
+{
+  bool surface = (cut_type == 3);
+  CSlice *s = surface ? slice_xy : slice_xz;
+  int ckey = field_type | (display_boundary << 4);
+  if((ckey != s->ckey) || (view_serial() != s->cview) || (alpha_fac != s->calpha)) {
+    class CTexels : public CLoop { // slice cells only, rows (v)
+    public:
+      CTexels(const CModel3D *m, CSlice *s, bool surface) : m(m), s(s), surface(surface) {
+        smin = 0; // hidden boundary
+        if(!m->display_boundary && (m->tfsf3d != NULL)) smin = m->tfsf3d->sb;
+      }
+      void run(long first, long last) {
+        double acut = surface ? 0.0 : 0.05; // skip low alphas (not surface)
+        long w = s->w;
+        for(long v = first; v < last; v++) {
+          for(long u = 0; u < w; u++) {
+            long i = u;
+            long j = surface ? v : SIZEY / 2;
+            long k = surface ? SIZEZ / 2 : v;
+            size_t n = i + j * SIZEX + k * SIZEX * SIZEY;
+            size_t c = u + v * w;
+#ifdef SOLVER_THREAD
+            double eh = m->view[n];
+#else
+            double eh = m->field(n);
+#endif
+            double alpha = ACUTM * fabs(eh);
+            if(alpha < acut) alpha = 0.0;
+            if((smin != 0) && ((i < smin) || (j < smin) || (k < smin) ||
+               (i >= SIZEX - smin) || (j >= SIZEY - smin) || (k >= SIZEZ - smin))) alpha = 0.0;
+            m->cloud->map_color(eh, m->alpha_fac * alpha, s->color + 4 * c);
+            if(surface) s->vertex[3 * c + 2] = eh;
+          }
         }
-        x = -0.5 + i / (SIZEX - 1.0);
-        y = -0.5 + j / (SIZEY - 1.0);
-        if(cut_type > 2) z = eh; // surface or line?
-        else z = -0.5 + k / (SIZEZ - 1.0);
-        if(dither && (cut_type != 4))
-          if(p->run)
-            glVertex3d((skip * randpm() / SIZEX) + x,
-                       (skip * randpm() / SIZEY) + y,
-                       (skip * randpm() / SIZEZ) + z);
-          else
-            glVertex3d((skip * space3d->d[n] / SIZEX) + x,
-                       (skip * space3d->d[2 * n] / SIZEY) + y,
-                       (skip * space3d->d[3 * n] / SIZEZ) + z);
-        else glVertex3d(x, y, z);
       }
-    }
+    private:
+      const CModel3D *m;
+      CSlice *s;
+      bool surface;
+      long smin;
+    } texels(this, s, surface);
+    parallelFor(s->h, texels);
+    s->changed = true;
+    s->ckey = ckey;
+    s->cview = view_serial();
+    s->calpha = alpha_fac;
   }
-  glEnd();
+  s->draw(surface);
+}
+
+void CModel3D::update_iso() const // extract for new fields or level
+{
+  int ckey = field_type | (display_boundary << 4);
+  if((ckey == iso->ckey) && (view_serial() == iso->cview) && (alpha_fac == iso->calpha)) return;
+  magnitude(iso->field);
+  iso->extract(ISO_LEVEL / alpha_fac);
+  iso->ckey = ckey;
+  iso->cview = view_serial();
+  iso->calpha = alpha_fac;
+}
+
+void CModel3D::draw_iso() const
+{
+  update_iso();
+  glPushMatrix();
+  glTranslatef(-0.5, -0.5, -0.5);
+  glScalef(1.0 / (SIZEX - 1), 1.0 / (SIZEY - 1), 1.0 / (SIZEZ - 1));
+  iso->draw();
+  glPopMatrix();
+}
+
+bool CModel3D::write_surface(const char *file) const // the displayed isosurface
+{
+  update_iso();
+  return iso->write_obj(file);
+}
+
+void CModel3D::draw() const  // right handed space
+{
+  if(objects != 0) glCallList(objects);
+  if(cut_type == 5) draw_iso();
+#ifdef SLICE_TEXTURE
+  else if(((cut_type == 2) || (cut_type == 3)) && (skip == 1) && !dither) draw_slice();
+  else points()->draw(); // & thinned or dithered cuts (per point positions)
+#else
+  else points()->draw();
+#endif
 
   if(display_bbox) glCallList(bbox);
 
   if(display_yee) {
-    glPushMatrix();
-    glScaled(1.0 / SIZEX, 1.0 / SIZEY, 1.0 / SIZEZ);
-    for(size_t k = 0; k <= SIZEZ; k++) {
-      for(size_t j = 0; j <= SIZEY; j++) {
-        for(size_t i = 0; i <= SIZEX; i++) {
-          glPushMatrix();
-          glTranslated(i - SIZEX / 2.0, j - SIZEY / 2.0, k - SIZEZ / 2.0);
-          space3d->draw_yee();
-          glPopMatrix();
-        }
+    int key = cut_type | (display_boundary << 3) | (skip << 4);
+    if(key != yee->key) { // lattice points of the visible cut region
+      size_t i0, j0, k0, i1, j1, k1;
+      i0 = j0 = k0 = 0;
+      i1 = SIZEX; j1 = SIZEY; k1 = SIZEZ;
+      if(!display_boundary && (tfsf3d != NULL)) {
+        i0 = j0 = k0 = tfsf3d->sb;
+        i1 = SIZEX - tfsf3d->sb; j1 = SIZEY - tfsf3d->sb; k1 = SIZEZ - tfsf3d->sb;
       }
+      if(cut_type == 1) j0 = (j0 > SIZEY / 2) ? j0 : SIZEY / 2; // half
+      else if(cut_type == 2) j0 = j1 = SIZEY / 2; // slice
+      else if(cut_type == 3) k0 = k1 = SIZEZ / 2; // surface
+      else if(cut_type == 4) {j0 = j1 = SIZEY / 2; k0 = k1 = SIZEZ / 2;} // line
+      yee->build(i0, i1, j0, j1, k0, k1, skip);
+      yee->key = key;
     }
-    glPopMatrix();
+    yee->draw();
   }
 }
 
@@ -394,5 +1043,10 @@ void CModel3D::get_status(QString &s) const
   else if(cut_type == 2) s.append(", slice");
   else if(cut_type == 3) s.append(", surface");
   else if(cut_type == 4) s.append(", line");
-  if(dither && (cut_type != 4)) s.append(", dither");
+  else if(cut_type == 5) s.append(", iso");
+  if(dither && (cut_type < 4)) s.append(", dither");
+  if(subgrid3d != NULL) s.append(", subgrid x" + QString::number(subgrid3d->ratio));
+  if(conformal3d != NULL) s.append(", conformal dt x" + QString::number(conformal3d->dtf, 'f', 2));
+  int l = lod_level();
+  if(l > 0) s.append(", lod " + QString::number(l));
 }
@@ -23,20 +23,39 @@ rugis@msu.edu
 #ifndef MODEL3D_H
 #define MODEL3D_H
 
+#include <vector>
+
 #include "model.h"
 
 class CSpaceEH3d;
 class CAbc1o3d;
 class CTfsf3d;
+class CSubgrid3d;
+class CConformal3d;
+class CPointCloud;
+class CPyramid;
+class CYeeLattice;
+class CSlice;
+class CIsosurface;
+class CMesh;
 
 class CModel3D : public CModel
 {
 public:
   CModel3D(GLWidget *parent = 0);
+  ~CModel3D();
 
+  void init_gl();
+  void set_profile() const;
   void reset();
   void step();
   void draw() const;
+  CPointCloud *points() const;
+  size_t cells() const;
+  size_t snap_size() const;
+  void snap(float *v) const;
+  void checksum(CChecksum &c) const;
+  bool write_surface(const char *file) const;
   void get_status(QString &s) const;
   void inc_field_type();
   void inc_cut_type();
@@ -45,10 +64,32 @@ private:
   CSpaceEH3d *space3d; // 3d space
   CAbc1o3d *abc1o3d; // first order abc
   CTfsf3d *tfsf3d; // tfsf in 3d space
+  CSubgrid3d *subgrid3d; // refined region
+  CConformal3d *conformal3d; // conformal pec object
   GLuint objects;
+  std::vector<CMesh *> meshes; // mesh objects as loaded (NULL: failed), drawn by init_gl
+  CPointCloud *cloud; // display points
+  CPyramid *pyramid; // max-pooled |field| (level of detail)
+  CPointCloud *lod;   // display points, all pyramid levels
+  size_t *lod_off;    // lod cloud offset of each level
+  CYeeLattice *yee;   // Yee cell overlay
+  CSlice *slice_xz;   // display texture (slice)
+  CSlice *slice_xy;   // display texture & heightfield (surface)
+  CIsosurface *iso;   // |field| level surface (iso)
 
   size_t time_step;  // time step
   void set_material();
+  double field(size_t n) const;
+  void magnitude(float *f) const;
+  unsigned int view_serial() const;
+  void draw_list() const;
+  void draw_slice() const;
+  void update_iso() const;
+  void draw_iso() const;
+  int lod_level() const;
+  void lod_list(int l) const;
+  void lod_refine(int l, size_t i, size_t j, size_t k, size_t &v) const;
+  CPointCloud *lod_points(int l) const;
 };
 
 #endif // MODEL3D_H
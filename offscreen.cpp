@@ -0,0 +1,257 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <cstdio>
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "defs.h"
+#include "utils.h"
+#include "model.h"
+#include "model2d.h"
+#include "model3d.h"
+#include "pointcloud.h"
+#include "offscreen.h"
+#include "profiler.h"
+
+// NOTES:
+//  1) camera as the GLWidget default view (13 inch display): eye distance ED,
+//     screen height SH, object scale OH; no ortho or stereo
+//  2) points are blended in draw (far to near) order without a depth buffer,
+//     display objects, the 3D iso & the 2D line cut are not drawn (see RENDER_USAGE);
+//     cuts & fields are the model's point cloud views (as the GLWidget keys)
+//  3) raw frames are the QImage RGB32 bytes (bgra on little endian hosts), e.g.
+//     ffmpeg -f rawvideo -pix_fmt bgra -s 800x800 -i frame_%05d.raw out.mp4
+
+#define ED 0.6   // EYE_DISTANCE (meters)
+#define SH 0.176 // SCREEN_HEIGHT
+#define OH 0.1   // OBJECT_HEIGHT
+#define TT ((SH/2.0)/ED) // TAN_THETA
+#define FRN (ED*0.1)     // FRUSTUM_NEAR
+
+#define RENDER_SIZE 800     // image pixels (square)
+#define RENDER_TILT 20.0    // degrees
+#define RENDER_ROTATE -35.0 // degrees
+#define RENDER_QUEUE 2      // frames queued per pool thread (then the solver waits)
+#define RENDER_USAGE \
+  "usage: -render [dimension 2|3] [steps] [frame every n steps] [png|raw] [cut] [field]\n" \
+  "  3D cuts: full half slice surface line, fields: Exyz Ex Ey Ez Hxyz Hx Hy Hz ExyzHxyz\n" \
+  "  2D cuts: surface flat, fields: Ez Hx Hy Hxy EzHxy\n" \
+  "  draws the field points & bounding box only: display objects (spheres,\n" \
+  "  meshes, subgrid outlines), the 3D iso & the 2D line cut are not drawn\n"
+
+// cut & field names by model cut_type & field_type (as the status bar)
+static const char *cuts3d[] = {"full", "half", "slice", "surface", "line", NULL};
+static const char *fields3d[] = {"Exyz", "Ex", "Ey", "Ez", "Hxyz", "Hx", "Hy", "Hz", "ExyzHxyz", NULL};
+static const char *cuts2d[] = {"surface", "flat", NULL};
+static const char *fields2d[] = {"Ez", "Hx", "Hy", "Hxy", "EzHxy", NULL};
+
+static int lookup(const char *const *names, int argc, char *argv[], int i) // 0: default, -1: unknown
+{
+  if(argc <= i) return 0;
+  for(int n = 0; names[n] != NULL; n++) if(strcmp(argv[i], names[n]) == 0) return n;
+  return -1;
+}
+
+static QAtomicInt pending; // queued & running frames
+
+COffscreen::COffscreen(int w, int h, double tilt, double rotate, double scale)
+{
+  width = w;
+  height = h;
+  point_size = 1;
+  clear = 0xffcccccc; // LIGHTGREY
+  display_bbox = true;
+
+  // as GLWidget::draw(): rotate tilt (x), rotate (z), scale
+  double t = tilt * PI / 180.0;
+  double r = rotate * PI / 180.0;
+  double rz[3][3] = {{cos(r), -sin(r), 0.0}, {sin(r), cos(r), 0.0}, {0.0, 0.0, 1.0}};
+  double rx[3][3] = {{1.0, 0.0, 0.0}, {0.0, cos(t), -sin(t)}, {0.0, sin(t), cos(t)}};
+  for(int i = 0; i < 3; i++) {
+    for(int j = 0; j < 3; j++) {
+      m[i][j] = 0.0;
+      for(int k = 0; k < 3; k++) m[i][j] += rx[i][k] * rz[k][j];
+      m[i][j] *= scale / WSF;
+    }
+  }
+}
+
+// as GLWidget::reset_projection(): rotate -90 (x), translate -ED (z), frustum
+bool COffscreen::project(double x, double y, double z, double *px, double *py) const
+{
+  double wx = m[0][0] * x + m[0][1] * y + m[0][2] * z;
+  double wy = m[1][0] * x + m[1][1] * y + m[1][2] * z;
+  double wz = m[2][0] * x + m[2][1] * y + m[2][2] * z;
+  double d = wy + ED; // eye distance (-z eye)
+  if(d < FRN) return false;
+  int side = (width > height) ? width : height; // as GLWidget::resizeGL()
+  *px = 0.5 * (width - side) + 0.5 * (1.0 + wx / (TT * d)) * side;
+  *py = height - (0.5 * (height - side) + 0.5 * (1.0 + wz / (TT * d)) * side);
+  return true;
+}
+
+void COffscreen::draw(const float *xyz, const unsigned char *rgba, size_t n, QImage *image) const
+{
+  int h0 = point_size / 2;
+  for(size_t p = 0; p < n; p++) {
+    double px, py;
+    if(!project(xyz[3 * p], xyz[3 * p + 1], xyz[3 * p + 2], &px, &py)) continue;
+    const unsigned char *c = rgba + 4 * p;
+    unsigned int a = c[3];
+    int x0 = int(floor(px)) - h0;
+    int y0 = int(floor(py)) - h0;
+    for(int y = y0; y < y0 + point_size; y++) {
+      if((y < 0) || (y >= height)) continue;
+      unsigned int *row = (unsigned int *)image->scanLine(y);
+      for(int x = x0; x < x0 + point_size; x++) {
+        if((x < 0) || (x >= width)) continue;
+        unsigned int d = row[x];
+        unsigned int r = (a * c[0] + (255 - a) * ((d >> 16) & 0xff)) / 255;
+        unsigned int g = (a * c[1] + (255 - a) * ((d >> 8) & 0xff)) / 255;
+        unsigned int b = (a * c[2] + (255 - a) * (d & 0xff)) / 255;
+        row[x] = 0xff000000 | (r << 16) | (g << 8) | b;
+      }
+    }
+  }
+
+  if(display_bbox) {
+    for(int e = 0; e < 12; e++) { // edges: 4 along each axis
+      int a = e / 4;
+      int b = (a + 1) % 3;
+      int c = (a + 2) % 3;
+      double p0[3], p1[3];
+      p0[a] = -0.5; p1[a] = 0.5;
+      p0[b] = p1[b] = (e & 1) ? 0.5 : -0.5;
+      p0[c] = p1[c] = (e & 2) ? 0.5 : -0.5;
+      line(image, p0, p1, 0xff4d4d4d);
+    }
+  }
+}
+
+void COffscreen::line(QImage *image, const double *a, const double *b, unsigned int c) const
+{
+  double x0, y0, x1, y1;
+  if(!project(a[0], a[1], a[2], &x0, &y0) || !project(b[0], b[1], b[2], &x1, &y1)) return;
+  int n = int(ceil(fabs(x1 - x0) > fabs(y1 - y0) ? fabs(x1 - x0) : fabs(y1 - y0))) + 1;
+  for(int i = 0; i <= n; i++) {
+    int x = int(floor(x0 + (x1 - x0) * i / n));
+    int y = int(floor(y0 + (y1 - y0) * i / n));
+    if((x < 0) || (x >= width) || (y < 0) || (y >= height)) continue;
+    ((unsigned int *)image->scanLine(y))[x] = c;
+  }
+}
+
+CFrameJob::CFrameJob(const COffscreen &rr, const CPointCloud *pc, const QString &f, bool rw)
+  : r(rr), xyz(3 * pc->visible), rgba(4 * pc->visible)
+{
+  for(size_t p = 0; p < pc->visible; p++) {
+    size_t n = pc->list[p];
+    for(int i = 0; i < 3; i++) xyz[3 * p + i] = pc->vertex[3 * n + i];
+    for(int i = 0; i < 4; i++) rgba[4 * p + i] = pc->color[4 * n + i];
+  }
+  file = f;
+  raw = rw;
+  pending.ref();
+}
+
+void CFrameJob::run()
+{
+  QImage image(r.width, r.height, QImage::Format_RGB32);
+  image.fill(r.clear);
+  r.draw(xyz.empty() ? NULL : &xyz[0], rgba.empty() ? NULL : &rgba[0], rgba.size() / 4, &image);
+  if(raw) {
+    std::ofstream out(file.toStdString().c_str(), std::ios::binary);
+    for(int y = 0; y < r.height; y++) out.write((const char *)image.scanLine(y), 4 * r.width);
+  }
+  else image.save(file, "PNG");
+  pending.deref();
+}
+
+// -render [dimension 2|3] [steps] [frame every n steps] [png|raw] [cut] [field] (RENDER_USAGE)
+int renderMain(int argc, char *argv[])
+{
+  int dim = (argc > 2) ? atoi(argv[2]) : 3;
+  int steps = (argc > 3) ? atoi(argv[3]) : 1000;
+  int every = (argc > 4) ? atoi(argv[4]) : 10;
+  bool raw = (argc > 5) && (strcmp(argv[5], "raw") == 0);
+  bool png = (argc <= 5) || (strcmp(argv[5], "png") == 0);
+  const char *const *cuts = (dim == 2) ? cuts2d : cuts3d;
+  const char *const *fields = (dim == 2) ? fields2d : fields3d;
+  int cut = lookup(cuts, argc, argv, 6);
+  int field = lookup(fields, argc, argv, 7);
+  if(((dim != 2) && (dim != 3)) || (steps < 0) || !(raw || png) || (cut < 0) || (field < 0)) {
+    printf("%s", RENDER_USAGE);
+    return 2;
+  }
+  if(every < 1) every = 1;
+
+  CModel *model;
+  if(dim == 2) model = new CModel2D(NULL);
+  else model = new CModel3D(NULL);
+  if(!model->error.isEmpty()) {
+    printf("%s render: %s\n", TITLE, model->error.toStdString().c_str());
+    delete model;
+    return 1;
+  }
+  COffscreen r(RENDER_SIZE, RENDER_SIZE, RENDER_TILT, RENDER_ROTATE, OH);
+  if(dim == 2) r.clear = 0xff000000; // BLACK
+  model->face = forward_face(RENDER_TILT, RENDER_ROTATE, &(model->xp), &(model->yp), &(model->zp));
+  model->zoom = RENDER_SIZE * OH / (WSF * SH);
+  model->cut_type = cut;
+  model->field_type = field;
+  std::vector<float> view(model->snap_size() + 1); // display snapshot (SOLVER_THREAD draw)
+  model->view = &view[0];
+
+#ifdef PROFILE_COUNTERS
+  if(!profiler.attach_counters()) printf("%s render: no hardware counters (perf_event)\n", TITLE);
+#endif
+  QThreadPool *pool = QThreadPool::globalInstance();
+  int frames = 0;
+  for(int s = 0; s <= steps; s++) {
+    if((s % every) == 0) {
+      model->snap(&view[0]);
+      model->view_id++; // new field values
+      CPointCloud *pc = model->points();
+      if(pc == NULL) break;
+      while(int(pending) >= RENDER_QUEUE * pool->maxThreadCount()) QThread::msleep(1);
+      char file[32];
+      sprintf(file, raw ? "frame_%05d.raw" : "frame_%05d.png", frames++);
+      pool->start(new CFrameJob(r, pc, file, raw));
+    }
+    if(s < steps) model->step();
+  }
+  pool->waitForDone();
+  delete model;
+#ifdef PROFILE
+  profiler.write("render_profile.json");
+#endif
+  printf("%s render: %d frames, %dD %s %s, %dx%d%s (points & bounding box only)\n", TITLE, frames,
+         (dim == 2) ? 2 : 3, cuts[cut], fields[field], RENDER_SIZE, RENDER_SIZE, raw ? " raw" : "");
+  return 0;
+}
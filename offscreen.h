@@ -0,0 +1,71 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef OFFSCREEN_H
+#define OFFSCREEN_H
+
+#include <QImage>
+#include <QRunnable>
+#include <QString>
+#include <vector>
+
+class CPointCloud;
+
+// software point renderer (no OpenGL): a model's display points, alpha
+// blended in draw order, through the GLWidget default perspective camera
+class COffscreen
+{
+public:
+  COffscreen(int w, int h, double tilt, double rotate, double scale);
+
+  int width, height;
+  int point_size;        // pixels
+  unsigned int clear;    // background (QImage RGB32)
+  bool display_bbox;
+
+  void draw(const float *xyz, const unsigned char *rgba, size_t n, QImage *image) const;
+
+private:
+  double m[3][3];        // model rotation & scale
+  bool project(double x, double y, double z, double *px, double *py) const;
+  void line(QImage *image, const double *a, const double *b, unsigned int c) const;
+};
+
+// one frame: the visible points are copied so the model can step on
+class CFrameJob : public QRunnable
+{
+public:
+  CFrameJob(const COffscreen &r, const CPointCloud *pc, const QString &file, bool raw);
+  void run();
+
+private:
+  COffscreen r;
+  std::vector<float> xyz;
+  std::vector<unsigned char> rgba;
+  QString file;
+  bool raw;
+};
+
+int renderMain(int argc, char *argv[]); // headless frames (-render)
+
+#endif // OFFSCREEN_H
@@ -0,0 +1,103 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "parallel.h"
+
+#define PARALLEL_RANGES 8 // ranges per thread (load balance)
+
+// NOTES:
+//  1) ranges are claimed from a shared counter, so uneven work balances
+//     (a dynamic schedule) & the caller works too: a call from a
+//     pool thread, or with the pool busy, still finishes (alone if need be)
+//  2) the shared state is freed by its last user, a helper started after
+//     all ranges are claimed finds none and never touches the loop
+
+class CParallelState
+{
+public:
+  CLoop *loop;
+  long n, size;      // indices, range size
+  int ranges;
+  QAtomicInt next;   // next unclaimed range
+  QAtomicInt done;   // finished ranges
+  QAtomicInt users;  // caller & helpers still holding the state
+  QMutex mutex;
+  QWaitCondition finished;
+
+  void work() {
+    int r;
+    while((r = next.fetchAndAddOrdered(1)) < ranges) {
+      long first = r * size;
+      long last = (first + size < n) ? first + size : n;
+      loop->run(first, last);
+      if(done.fetchAndAddOrdered(1) + 1 == ranges) {
+        QMutexLocker lock(&mutex);
+        finished.wakeAll();
+      }
+    }
+  }
+  void release() {if(!users.deref()) delete this;}
+};
+
+class CParallelJob : public QRunnable
+{
+public:
+  CParallelJob(CParallelState *s) : s(s) {}
+  void run() {s->work(); s->release();}
+private:
+  CParallelState *s;
+};
+
+void parallelFor(long n, CLoop &loop, long grain)
+{
+  if(n <= 0) return;
+  if(grain < 1) grain = 1;
+  QThreadPool *pool = QThreadPool::globalInstance();
+  int threads = pool->maxThreadCount();
+  long size = (n + long(threads) * PARALLEL_RANGES - 1) / (long(threads) * PARALLEL_RANGES);
+  if(size < grain) size = grain;
+  int ranges = int((n + size - 1) / size);
+  if((threads < 2) || (ranges < 2)) { // serial
+    loop.run(0, n);
+    return;
+  }
+
+  CParallelState *s = new CParallelState;
+  s->loop = &loop;
+  s->n = n;
+  s->size = size;
+  s->ranges = ranges;
+  int helpers = (threads - 1 < ranges - 1) ? threads - 1 : ranges - 1;
+  s->users = helpers + 1;
+  for(int h = 0; h < helpers; h++) pool->start(new CParallelJob(s));
+  s->work();
+  s->mutex.lock();
+  while(int(s->done) < ranges) s->finished.wait(&s->mutex);
+  s->mutex.unlock();
+  s->release();
+}
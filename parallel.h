@@ -0,0 +1,39 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// a loop body: run(first, last) does indices [first, last)
+// called from several threads at once on disjoint ranges
+class CLoop
+{
+public:
+  virtual ~CLoop() {}
+  virtual void run(long first, long last) = 0;
+};
+
+// [0, n) split into ranges of at least grain indices, taken in turn by the
+// calling thread & the global thread pool, returns when all are done
+void parallelFor(long n, CLoop &loop, long grain = 1);
+
+#endif // PARALLEL_H
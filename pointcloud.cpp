@@ -0,0 +1,205 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include "utils.h"
+#include "pointcloud.h"
+#include "parallel.h"
+
+#define BLOCKS 256 // compaction blocks
+
+static unsigned char ubyte(double c) // clamped as glColor
+{
+  if(c <= 0.0) return 0;
+  if(c >= 1.0) return 255;
+  return (unsigned char)(255.0 * c + 0.5);
+}
+
+// NOTES:
+//  1) vertices, colors & the compacted draw list are uploaded only when changed
+//     (moved, colored), so a paused view redraws from the buffers as they are
+//  2) zero alpha points are dropped by compact(), any left (alpha rounding to
+//     zero) are discarded by the alpha test so they never write depth
+//  3) compaction is a blocked parallel prefix sum: count per block, scan the
+//     block counts, then each block writes from its own offset (order kept)
+//  4) the color map covers max * 10^-(decades + 1) to max * 10, values outside
+//     take the end colors (the hue is already clamped at the low end)
+
+CPointCloud::CPointCloud(size_t n, double decades, double max, double v)
+  : vbuf(QGLBuffer::VertexBuffer), cbuf(QGLBuffer::VertexBuffer), ibuf(QGLBuffer::IndexBuffer)
+{
+  size = n;
+  vertex = new float[3 * size];
+  color = new unsigned char[4 * size];
+  index = new GLuint[size];
+  list = new GLuint[size];
+  count = visible = 0;
+  key = ckey = -1;
+  dseed = 0;
+  cview = 0;
+  calpha = 0.0;
+  moved = false;
+  colored = true;
+  for(size_t i = 0; i < 3 * size; i++) vertex[i] = 0.0;
+  for(size_t i = 0; i < 4 * size; i++) color[i] = 0;
+
+  // color map, bin centre hues as the immediate mode draw
+  float lo = float(max * pow(10.0, -(decades + 1.0)));
+  float hi = float(max * 10.0);
+  memcpy(&b0, &lo, sizeof(b0));
+  memcpy(&b1, &hi, sizeof(b1));
+  b0 >>= 23 - CMAP_BITS;
+  b1 >>= 23 - CMAP_BITS;
+  cmap = new unsigned char[3 * (b1 - b0 + 1)];
+  HSV hsv;
+  RGB rgb;
+  hsv.s = 1.0;
+  hsv.v = v;
+  for(unsigned int b = b0; b <= b1; b++) {
+    unsigned int u = (b << (23 - CMAP_BITS)) | (1u << (22 - CMAP_BITS));
+    float a;
+    memcpy(&a, &u, sizeof(a));
+    hsv.h = (-360.0 / (decades * log(10.0))) * log(a / max);
+    if(hsv.h >= 360.0) hsv.h = 359.9; // clamp at max
+    HSVtoRGB(&hsv, &rgb);
+    unsigned char *c = cmap + 3 * (b - b0);
+    c[0] = ubyte(rgb.r);
+    c[1] = ubyte(rgb.g);
+    c[2] = ubyte(rgb.b);
+  }
+
+  gl = vbo = false;
+}
+
+CPointCloud::~CPointCloud()
+{
+  if(vbo) {
+    vbuf.destroy();
+    cbuf.destroy();
+    ibuf.destroy();
+  }
+  delete[] vertex;
+  delete[] color;
+  delete[] index;
+  delete[] list;
+  delete[] cmap;
+}
+
+void CPointCloud::init_gl()
+{
+  gl = true;
+  vbo = vbuf.create() && cbuf.create() && ibuf.create();
+  if(vbo) {
+    vbuf.setUsagePattern(QGLBuffer::StaticDraw);
+    vbuf.bind();
+    vbuf.allocate(vertex, 3 * size * sizeof(float));
+    vbuf.release();
+    cbuf.setUsagePattern(QGLBuffer::StreamDraw);
+    cbuf.bind();
+    cbuf.allocate(4 * size);
+    cbuf.release();
+    ibuf.setUsagePattern(QGLBuffer::StreamDraw);
+    ibuf.bind();
+    ibuf.allocate(size * sizeof(GLuint));
+    ibuf.release();
+  }
+}
+
+void CPointCloud::compact()
+{
+  class CBlocks : public CLoop { // count (or copy) visible points per block
+  public:
+    CBlocks(CPointCloud *c, size_t *start) : c(c), start(start), copy(false) {
+      bs = (c->count + BLOCKS - 1) / BLOCKS;
+    }
+    void run(long first, long last) {
+      for(long b = first; b < last; b++) {
+        size_t m1 = (b + 1) * bs < c->count ? (b + 1) * bs : c->count;
+        if(copy) {
+          GLuint *l = c->list + start[b];
+          for(size_t m = b * bs; m < m1; m++) {
+            GLuint n = c->index[m];
+            if(c->color[4 * n + 3] != 0) *l++ = n;
+          }
+        }
+        else {
+          size_t v = 0;
+          for(size_t m = b * bs; m < m1; m++) v += (c->color[4 * c->index[m] + 3] != 0);
+          start[b + 1] = v;
+        }
+      }
+    }
+    CPointCloud *c;
+    size_t *start;
+    size_t bs;
+    bool copy;
+  };
+
+  size_t start[BLOCKS + 1];
+  start[0] = 0;
+  CBlocks blocks(this, start);
+  parallelFor(BLOCKS, blocks);
+  for(int b = 0; b < BLOCKS; b++) start[b + 1] += start[b]; // block offsets
+  blocks.copy = true;
+  parallelFor(BLOCKS, blocks);
+  visible = start[BLOCKS];
+  colored = true;
+}
+
+void CPointCloud::draw()
+{
+  if(!gl) init_gl();
+  else if(moved && vbo) {
+    vbuf.bind();
+    vbuf.write(0, vertex, 3 * size * sizeof(float));
+    vbuf.release();
+  }
+  moved = false;
+  if(visible == 0) return;
+  glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+  glAlphaFunc(GL_GREATER, 0.0);
+  glEnable(GL_ALPHA_TEST);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  if(vbo) {
+    vbuf.bind();
+    glVertexPointer(3, GL_FLOAT, 0, 0);
+    cbuf.bind();
+    if(colored) cbuf.write(0, color, 4 * size);
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, 0);
+    ibuf.bind();
+    if(colored) ibuf.write(0, list, visible * sizeof(GLuint));
+    colored = false;
+    glDrawElements(GL_POINTS, visible, GL_UNSIGNED_INT, 0);
+    ibuf.release();
+    cbuf.release();
+    vbuf.release();
+  }
+  else {
+    glVertexPointer(3, GL_FLOAT, 0, vertex);
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, color);
+    glDrawElements(GL_POINTS, visible, GL_UNSIGNED_INT, list);
+  }
+  glPopClientAttrib();
+  glPopAttrib();
+}
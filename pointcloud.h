@@ -0,0 +1,92 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef POINTCLOUD_H
+#define POINTCLOUD_H
+
+#include <QtOpenGL>
+#include <QGLBuffer>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define CMAP_BITS 6 // color map entries per octave: 2^CMAP_BITS
+
+// one point per cell drawn from vertex buffers (client arrays without VBOs)
+// no OpenGL calls before the first draw(), so it also serves headless renders
+// the owner fills a draw list (cell indices, far to near) and per cell
+// vertices when its key changes, then per frame colors from field values;
+// compact() keeps the non-transparent points (in order) for drawing;
+// colors are kept while their key, field values & alpha factor hold (paused views)
+class CPointCloud
+{
+public:
+  CPointCloud(size_t n, double decades, double max, double v);
+  ~CPointCloud();
+
+  size_t size;           // cells
+  float *vertex;         // xyz per cell
+  unsigned char *color;  // rgba per cell
+  GLuint *index;         // draw list
+  size_t count;          // draw list length
+  GLuint *list;          // compacted draw list (visible points)
+  size_t visible;        // compacted draw list length
+  int key;               // draw list state (owner defined, -1 = none)
+  unsigned int dseed;    // draw list state: dither seed of the vertices
+  int ckey;              // color state (owner defined, -1 = none)
+  unsigned int cview;    // color state: field values (owner defined serial)
+  double calpha;         // color state: alpha factor
+  bool moved;            // vertices changed (uploaded by the next draw)
+  bool colored;          // colors or compacted list changed (compact(), uploaded by the next draw)
+
+  // color map replaces per point log & HSV: indexed by the float exponent
+  // and top mantissa bits of |eh|, i.e. log spaced, 2^CMAP_BITS per octave
+  void set_color(size_t n, double eh, double alpha) {map_color(eh, alpha, color + 4 * n);}
+  void map_color(double eh, double alpha, unsigned char *p) const // rgba (also for textures)
+  {
+    float a = float(fabs(eh));
+    unsigned int b;
+    memcpy(&b, &a, sizeof(b));
+    b >>= 23 - CMAP_BITS;
+    const unsigned char *c = cmap + 3 * ((b < b0) ? 0 : ((b > b1) ? b1 - b0 : b - b0));
+    p[0] = c[0]; p[1] = c[1]; p[2] = c[2];
+    p[3] = (alpha >= 1.0) ? 255 : ((alpha > 0.0) ? (unsigned char)(255.0 * alpha) : 0);
+  }
+  void set_color(size_t n, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+  {
+    unsigned char *p = color + 4 * n;
+    p[0] = r; p[1] = g; p[2] = b; p[3] = a;
+  }
+  void compact();         // after color changes
+  void draw();
+
+private:
+  void init_gl();
+  bool gl;               // buffers created? (on the first draw)
+  bool vbo;              // vertex buffer objects available?
+  QGLBuffer vbuf, cbuf, ibuf;
+  unsigned char *cmap;   // rgb
+  unsigned int b0, b1;   // color map range (float bits >> (23 - CMAP_BITS))
+};
+
+#endif // POINTCLOUD_H
@@ -0,0 +1,257 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <vector>
+#include <fstream>
+
+#include "defs.h"
+#ifdef PROFILE_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+#include "profiler.h"
+
+// NOTES:
+//  1) the mean is over all samples since the last reset, percentiles only
+//     over the most recent PROFILE_SAMPLES
+//  2) Mcells/s is cells / phase time; bytes/cell is the cell record size, so
+//     GB/s assumes one pass over every record (step, H & E only), a lower bound
+//  3) a phase timed more than once per step (e.g. two sources) has one sample each
+//  4) counters (PROFILE_COUNTERS) count the attached thread only (not the
+//     parallelFor helpers), DRAM bytes are LLC misses x cache line, so
+//     arithmetic intensity is flops per DRAM byte & prefetched lines are missed
+//  5) the roof is min(roof GFLOP/s, intensity x roof GB/s), read from ROOF_FILE
+//     at startup (-bench writes it: one thread peak & stream_triad); without
+//     it the roof & roof_fraction are 0 (unknown)
+//  6) counters need perf_event access (kernel.perf_event_paranoid <= 2),
+//     without it only times are reported
+
+#define CACHE_LINE 64     // bytes
+
+CProfiler profiler;
+
+static const char *phase_names[PHASES] = {
+  "step", "h", "tfsf_a", "source", "tfsf_b", "e", "abc", "output", "draw"
+};
+
+CProfiler::CProfiler()
+{
+  samples = new qint64[PHASES * PROFILE_SAMPLES];
+  cells = cell_bytes = 0;
+  for(int p = 0; p < PHASES; p++) flops[p] = 0.0;
+  for(int c = 0; c < COUNTERS; c++) perf_fd[c] = -1;
+  perf_thread = 0;
+  roof_gflops = roof_gbs = 0.0;
+  read_roof(ROOF_FILE);
+  clock.start();
+  reset();
+}
+
+void CProfiler::reset()
+{
+  QMutexLocker locker(&mutex);
+  for(int p = 0; p < PHASES; p++) {
+    start[p] = 0;
+    count[p] = 0;
+    total[p] = tmax[p] = 0;
+    tmin[p] = 0;
+    ccount[p] = 0;
+    for(int c = 0; c < COUNTERS; c++) ctotal[p][c] = 0;
+  }
+}
+
+void CProfiler::set_cells(size_t n, size_t b)
+{
+  reset();
+  cells = n;
+  cell_bytes = b;
+  for(int p = 0; p < PHASES; p++) flops[p] = 0.0;
+}
+
+bool CProfiler::attach_counters()
+{
+#ifdef PROFILE_COUNTERS
+  static const unsigned long long config[COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+  };
+  QMutexLocker locker(&mutex);
+  for(int c = 0; c < COUNTERS; c++) { // a new stepping thread
+    if(perf_fd[c] >= 0) close(perf_fd[c]);
+    perf_fd[c] = -1;
+  }
+  for(int c = 0; c < COUNTERS; c++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config[c];
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd[c] = syscall(__NR_perf_event_open, &attr, 0, -1, (c == 0) ? -1 : perf_fd[0], 0);
+    if(perf_fd[c] < 0) {
+      for(int i = 0; i < c; i++) {
+        close(perf_fd[i]);
+        perf_fd[i] = -1;
+      }
+      return false;
+    }
+  }
+  perf_thread = QThread::currentThreadId();
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool CProfiler::read_roof(const char *file)
+{
+  std::ifstream in(file);
+  double g, b;
+  if(!(in >> g >> b) || (g <= 0.0) || (b <= 0.0)) return false;
+  set_roof(g, b);
+  return true;
+}
+
+bool CProfiler::write_roof(const char *file) const
+{
+  std::ofstream out(file);
+  if(!out) return false;
+  out << roof_gflops << " " << roof_gbs << "\n";
+  return true;
+}
+
+void CProfiler::read_counters(quint64 *c) const
+{
+#ifdef PROFILE_COUNTERS
+  quint64 v[1 + COUNTERS]; // nr, values
+  if(read(perf_fd[0], v, sizeof(v)) != sizeof(v)) v[1] = v[2] = v[3] = 0;
+  for(int i = 0; i < COUNTERS; i++) c[i] = v[1 + i];
+#else
+  Q_UNUSED(c);
+#endif
+}
+
+void CProfiler::end(int p)
+{
+  qint64 t = clock.nsecsElapsed() - start[p];
+#ifdef PROFILE_COUNTERS
+  quint64 c[COUNTERS];
+  bool counted = (perf_fd[0] >= 0) && (QThread::currentThreadId() == perf_thread);
+  if(counted) read_counters(c);
+#endif
+  QMutexLocker locker(&mutex);
+#ifdef PROFILE_COUNTERS
+  if(counted) {
+    for(int i = 0; i < COUNTERS; i++) ctotal[p][i] += c[i] - cstart[p][i];
+    ccount[p]++;
+  }
+#endif
+  samples[p * PROFILE_SAMPLES + count[p] % PROFILE_SAMPLES] = t;
+  if((count[p] == 0) || (t < tmin[p])) tmin[p] = t;
+  if(t > tmax[p]) tmax[p] = t;
+  total[p] += t;
+  count[p]++;
+}
+
+void CProfiler::percentiles(int p, qint64 *q) const
+{
+  size_t n = (count[p] < PROFILE_SAMPLES) ? count[p] : PROFILE_SAMPLES;
+  if(n == 0) {
+    q[0] = q[1] = q[2] = 0;
+    return;
+  }
+  std::vector<qint64> s(samples + p * PROFILE_SAMPLES, samples + p * PROFILE_SAMPLES + n);
+  std::sort(s.begin(), s.end());
+  q[0] = s[(n - 1) * 50 / 100];
+  q[1] = s[(n - 1) * 90 / 100];
+  q[2] = s[(n - 1) * 99 / 100];
+}
+
+void CProfiler::get_status(QString &s) const
+{
+  QMutexLocker locker(&mutex);
+  for(int p = 0; p < PHASES; p++) {
+    if(count[p] == 0) continue;
+    s.append(", " + QString(phase_names[p]) + ":");
+    s.append(QString::number(total[p] / 1000.0 / count[p], 'f', 0));
+  }
+  if(count[PHASE_STEP] != 0)
+    s.append(", Mcells/s:" + QString::number(1000.0 * cells * count[PHASE_STEP] / total[PHASE_STEP], 'f', 1));
+}
+
+bool CProfiler::write(const QString &file) const
+{
+  std::ofstream out(file.toStdString().c_str());
+  if(!out) return false;
+  bool json = file.endsWith(".json");
+  QMutexLocker locker(&mutex);
+  if(json) out << "{\n  \"cells\": " << cells << ",\n  \"bytes_per_cell\": " << cell_bytes
+               << ",\n  \"roof_gflops\": " << roof_gflops << ",\n  \"roof_gb_s\": " << roof_gbs
+               << ",\n  \"phases\": [\n";
+  else out << "phase,count,min_ns,mean_ns,max_ns,p50_ns,p90_ns,p99_ns,mcells_s,gb_s,"
+              "cycles,instructions,ipc,llc_misses,dram_bytes,gflops,intensity,roof_gflops,roof_fraction\n";
+  bool first = true;
+  for(int p = 0; p < PHASES; p++) {
+    if(count[p] == 0) continue;
+    qint64 q[3];
+    percentiles(p, q);
+    double mean = double(total[p]) / count[p];
+    bool bulk = (p == PHASE_STEP) || (p == PHASE_H) || (p == PHASE_E); // whole grid phases
+    double mcells = bulk ? 1000.0 * cells / mean : 0.0;
+    double gbs = bulk ? double(cells) * cell_bytes / mean : 0.0;
+    double k[COUNTERS], ipc, dram, gflops, ai, roof, frac; // per sample
+    for(int i = 0; i < COUNTERS; i++) k[i] = ccount[p] ? double(ctotal[p][i]) / ccount[p] : 0.0;
+    ipc = (k[COUNT_CYCLES] > 0.0) ? k[COUNT_INSTRUCTIONS] / k[COUNT_CYCLES] : 0.0;
+    dram = CACHE_LINE * k[COUNT_LLC_MISSES];
+    gflops = flops[p] * cells / mean;
+    ai = (dram > 0.0) ? flops[p] * cells / dram : 0.0;
+    roof = (ai * roof_gbs < roof_gflops) ? ai * roof_gbs : roof_gflops;
+    frac = (ccount[p] && (roof > 0.0)) ? gflops / roof : 0.0;
+    if(json) {
+      out << (first ? "" : ",\n") << "    {\"phase\": \"" << phase_names[p] << "\", \"count\": " << count[p]
+          << ", \"min_ns\": " << tmin[p] << ", \"mean_ns\": " << mean << ", \"max_ns\": " << tmax[p]
+          << ", \"p50_ns\": " << q[0] << ", \"p90_ns\": " << q[1] << ", \"p99_ns\": " << q[2]
+          << ", \"mcells_s\": " << mcells << ", \"gb_s\": " << gbs
+          << ", \"cycles\": " << k[COUNT_CYCLES] << ", \"instructions\": " << k[COUNT_INSTRUCTIONS]
+          << ", \"ipc\": " << ipc << ", \"llc_misses\": " << k[COUNT_LLC_MISSES] << ", \"dram_bytes\": " << dram
+          << ", \"gflops\": " << gflops << ", \"intensity\": " << ai << ", \"roof_gflops\": " << roof
+          << ", \"roof_fraction\": " << frac << "}";
+    }
+    else {
+      out << phase_names[p] << "," << count[p] << "," << tmin[p] << "," << mean << "," << tmax[p]
+          << "," << q[0] << "," << q[1] << "," << q[2] << "," << mcells << "," << gbs
+          << "," << k[COUNT_CYCLES] << "," << k[COUNT_INSTRUCTIONS] << "," << ipc << "," << k[COUNT_LLC_MISSES]
+          << "," << dram << "," << gflops << "," << ai << "," << roof << "," << frac << "\n";
+    }
+    first = false;
+  }
+  if(json) out << "\n  ]\n}\n";
+  return true;
+}
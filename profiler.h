@@ -0,0 +1,101 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <stdlib.h>
+
+#include "defs.h"
+
+#define PROFILE_SAMPLES 1024 // most recent samples per phase (percentiles)
+#define ROOF_FILE "roof.txt"   // host roofs (written by -bench): GFLOP/s & GB/s, one core
+
+#ifdef PROFILE
+  #define PROFILE_BEGIN(p) profiler.begin(p)
+  #define PROFILE_END(p) profiler.end(p)
+#else
+  #define PROFILE_BEGIN(p)
+  #define PROFILE_END(p)
+#endif
+
+enum {COUNT_CYCLES, COUNT_INSTRUCTIONS, COUNT_LLC_MISSES, COUNTERS}; // PROFILE_COUNTERS
+
+// timed phases (named scopes)
+enum {PHASE_STEP, PHASE_H, PHASE_TFSF_A, PHASE_SOURCE, PHASE_TFSF_B, PHASE_E,
+      PHASE_ABC, PHASE_OUTPUT, PHASE_DRAW, PHASES};
+
+// nanosecond phase timing: count, min, mean & max of every sample, percentiles
+// of the most recent PROFILE_SAMPLES; each phase is timed by one thread only
+// (the solver or the display), statistics are read under the lock
+// with PROFILE_COUNTERS the stepping thread also reads hardware counters
+// (Linux perf_event) around its phases, for a roofline per phase
+class CProfiler
+{
+public:
+  CProfiler();
+
+  void begin(int p)
+  {
+#ifdef PROFILE_COUNTERS
+    if((perf_fd[0] >= 0) && (QThread::currentThreadId() == perf_thread)) read_counters(cstart[p]);
+#endif
+    start[p] = clock.nsecsElapsed();
+  }
+  void end(int p);
+  void reset();
+  void set_cells(size_t n, size_t b); // model cells & bytes per cell (record size)
+  void set_flops(int p, double f) {flops[p] = f;} // per cell, per phase
+  bool attach_counters(); // count the calling (stepping) thread's phases
+  void set_roof(double gflops, double gbs) {roof_gflops = gflops; roof_gbs = gbs;} // one core
+  bool read_roof(const char *file);
+  bool write_roof(const char *file) const;
+  void get_status(QString &s) const;  // mean phase times (us)
+  bool write(const QString &file) const; // JSON (*.json) or CSV
+
+private:
+  QElapsedTimer clock;
+  qint64 start[PHASES];
+  size_t count[PHASES];
+  qint64 total[PHASES], tmin[PHASES], tmax[PHASES];
+  qint64 *samples;    // PROFILE_SAMPLES ring per phase
+  size_t cells, cell_bytes;
+  double flops[PHASES];
+  double roof_gflops, roof_gbs; // host roofs (0: unknown)
+  int perf_fd[COUNTERS]; // counter group, [0] the leader (-1: none)
+  Qt::HANDLE perf_thread;
+  quint64 cstart[PHASES][COUNTERS], ctotal[PHASES][COUNTERS];
+  size_t ccount[PHASES]; // counted samples
+  mutable QMutex mutex;
+
+  void percentiles(int p, qint64 *q) const; // 50, 90 & 99th
+  void read_counters(quint64 *c) const;
+};
+
+extern CProfiler profiler;
+
+#endif // PROFILER_H
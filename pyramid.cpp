@@ -0,0 +1,93 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include "pyramid.h"
+#include "parallel.h"
+
+CPyramid::CPyramid(size_t sx, size_t sy, size_t sz, int l)
+{
+  levels = (l < PYRAMID_MAX) ? l : PYRAMID_MAX;
+  nx[0] = sx;
+  ny[0] = sy;
+  nz[0] = sz;
+  for(int i = 1; i <= levels; i++) {
+    nx[i] = (nx[i - 1] + 1) / 2;
+    ny[i] = (ny[i - 1] + 1) / 2;
+    nz[i] = (nz[i - 1] + 1) / 2;
+  }
+  for(int i = 0; i <= levels; i++) {
+    level[i] = new float[size(i)];
+    for(size_t n = 0; n < size(i); n++) level[i][n] = 0.0;
+  }
+}
+
+CPyramid::~CPyramid()
+{
+  for(int i = 0; i <= levels; i++) delete[] level[i];
+}
+
+void CPyramid::build()
+{
+  class CPool : public CLoop { // level l planes (k) from level l - 1
+  public:
+    CPool(const CPyramid *p, int l) : p(p), l(l) {}
+    void run(long first, long last) {
+      const float *f = p->level[l - 1];
+      float *c = p->level[l];
+      size_t fx = p->nx[l - 1];
+      size_t fy = p->ny[l - 1];
+      size_t fxy = fx * fy;
+      size_t fz = p->nz[l - 1];
+      for(long k = first; k < last; k++) {
+        size_t k0 = 2 * k;
+        size_t k1 = (k0 + 1 < fz) ? k0 + 1 : k0; // odd sizes: last block is one cell deep
+        for(size_t j = 0; j < p->ny[l]; j++) {
+          size_t j0 = 2 * j;
+          size_t j1 = (j0 + 1 < fy) ? j0 + 1 : j0;
+          for(size_t i = 0; i < p->nx[l]; i++) {
+            size_t i0 = 2 * i;
+            size_t i1 = (i0 + 1 < fx) ? i0 + 1 : i0;
+            float m = f[i0 + j0 * fx + k0 * fxy];
+            float v;
+            v = f[i1 + j0 * fx + k0 * fxy]; if(v > m) m = v;
+            v = f[i0 + j1 * fx + k0 * fxy]; if(v > m) m = v;
+            v = f[i1 + j1 * fx + k0 * fxy]; if(v > m) m = v;
+            v = f[i0 + j0 * fx + k1 * fxy]; if(v > m) m = v;
+            v = f[i1 + j0 * fx + k1 * fxy]; if(v > m) m = v;
+            v = f[i0 + j1 * fx + k1 * fxy]; if(v > m) m = v;
+            v = f[i1 + j1 * fx + k1 * fxy]; if(v > m) m = v;
+            c[i + j * p->nx[l] + k * p->nx[l] * p->ny[l]] = m;
+          }
+        }
+      }
+    }
+  private:
+    const CPyramid *p;
+    int l;
+  };
+
+  for(int l = 1; l <= levels; l++) {
+    CPool pool(this, l);
+    parallelFor(nz[l], pool);
+  }
+}
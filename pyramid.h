@@ -0,0 +1,50 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+#include <stdlib.h>
+
+#define PYRAMID_MAX 16 // most levels
+
+// multiresolution (max-pooled) field magnitude in a 3D space
+// level 0 is the full grid (filled by the owner), each level above halves
+// every dimension (rounding up) & keeps the largest value of its 2x2x2 block
+class CPyramid
+{
+public:
+  CPyramid(size_t sx, size_t sy, size_t sz, int l);
+  ~CPyramid();
+
+  int levels;                 // above level 0
+  size_t nx[PYRAMID_MAX + 1]; // level sizes
+  size_t ny[PYRAMID_MAX + 1];
+  size_t nz[PYRAMID_MAX + 1];
+  float *level[PYRAMID_MAX + 1];
+
+  size_t size(int l) const {return nx[l] * ny[l] * nz[l];}
+  void build(); // levels 1.. from level 0
+};
+
+#endif // PYRAMID_H
@@ -0,0 +1,128 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <QMutexLocker>
+#include <string.h>
+
+#include "replay.h"
+
+// NOTES:
+//  1) values are kept as bfloat16 (the top 16 bits of the float, truncated):
+//     sign, exponent & 7 mantissa bits, so the point cloud color bin
+//     (CMAP_BITS 6 mantissa bits) of every value is unchanged
+//  2) runs of exact zeros (space the wave hasn't reached) are coded as a zero
+//     word and a run length, halving memory at worst, far better early on
+//  3) the oldest frames are dropped to stay in budget (the newest is always kept)
+
+CReplay::CReplay(size_t n, size_t b)
+{
+  size = n;
+  budget = b;
+  used = 0;
+  out = new float[size];
+  for(size_t i = 0; i < size; i++) out[i] = 0.0;
+}
+
+CReplay::~CReplay()
+{
+  delete[] out;
+}
+
+void CReplay::record(const float *v, int tag)
+{
+  code.clear();
+  for(size_t n = 0; n < size;) {
+    unsigned int u;
+    memcpy(&u, v + n, sizeof(u));
+    if(u == 0) { // zero run
+      size_t r = 1;
+      while((n + r < size) && (r < 0xffff)) {
+        memcpy(&u, v + n + r, sizeof(u));
+        if(u != 0) break;
+        r++;
+      }
+      code.push_back(0);
+      code.push_back((unsigned short)r);
+      n += r;
+    }
+    else {
+      unsigned short w = (unsigned short)(u >> 16);
+      code.push_back(w ? w : 1); // a denormal (< 1e-38) codes as the smallest
+      n++;
+    }
+  }
+
+  QMutexLocker locker(&lock);
+  if(!ring.empty() && (ring.back().tag != tag)) {
+    ring.clear();
+    used = 0;
+  }
+  ring.push_back(CFrame());
+  ring.back().tag = tag;
+  ring.back().data.assign(code.begin(), code.end());
+  used += code.size() * sizeof(unsigned short);
+  while((used > budget) && (ring.size() > 1)) {
+    used -= ring.front().data.size() * sizeof(unsigned short);
+    ring.pop_front();
+  }
+}
+
+void CReplay::clear()
+{
+  QMutexLocker locker(&lock);
+  ring.clear();
+  used = 0;
+}
+
+int CReplay::frames() const
+{
+  QMutexLocker locker(&lock);
+  return int(ring.size());
+}
+
+size_t CReplay::bytes() const
+{
+  QMutexLocker locker(&lock);
+  return used;
+}
+
+const float *CReplay::frame(int i, int *tag)
+{
+  QMutexLocker locker(&lock);
+  if((i < 0) || (i >= int(ring.size()))) return NULL;
+  const CFrame &f = ring[i];
+  *tag = f.tag;
+  const unsigned short *d = &f.data[0];
+  size_t m = f.data.size();
+  size_t n = 0;
+  for(size_t k = 0; (k < m) && (n < size); k++) {
+    if(d[k] == 0) { // zero run
+      size_t r = d[++k];
+      for(size_t j = 0; j < r; j++) out[n++] = 0.0;
+    }
+    else {
+      unsigned int u = (unsigned int)d[k] << 16;
+      memcpy(out + n++, &u, sizeof(u));
+    }
+  }
+  return out;
+}
@@ -0,0 +1,60 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <QMutex>
+#include <deque>
+#include <vector>
+#include <stdlib.h>
+
+// ring buffer of past display snapshots, compressed, within a memory budget
+// written by the solver thread as it publishes, read (scrubbed) by the GUI
+class CReplay
+{
+public:
+  CReplay(size_t n, size_t b);
+  ~CReplay();
+
+  size_t size;   // floats per frame (snapshot size)
+  size_t budget; // bytes
+
+  void record(const float *v, int tag); // a new history if tag (field type) changes
+  void clear();
+  int frames() const;
+  const float *frame(int i, int *tag); // decoded, 0: oldest
+  size_t bytes() const;
+
+private:
+  struct CFrame {
+    int tag;
+    std::vector<unsigned short> data;
+  };
+  std::deque<CFrame> ring;
+  std::vector<unsigned short> code; // encoder scratch
+  size_t used;   // bytes held
+  float *out;    // decoded frame
+  mutable QMutex lock;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,192 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+#include <algorithm>
+
+#include "shape.h"
+
+bool CShape::inside(const double *p) const
+{
+  double t[MAX_CROSSINGS];
+  int n = crossings(0, p, t);
+  for(int m = 0; m + 1 < n; m += 2) if((p[0] >= t[m]) && (p[0] <= t[m + 1])) return true;
+  return false;
+}
+
+double CShape::outside(int axis, const double *p) const
+{
+  double t[MAX_CROSSINGS];
+  double l = 1.0;
+  int n = crossings(axis, p, t);
+  for(int m = 0; m + 1 < n; m += 2) {
+    double t0 = (t[m] > p[axis]) ? t[m] : p[axis];
+    double t1 = (t[m + 1] < p[axis] + 1.0) ? t[m + 1] : p[axis] + 1.0;
+    if(t1 > t0) l -= t1 - t0;
+  }
+  return (l > 0.0) ? l : 0.0;
+}
+
+CSphere::CSphere(double x, double y, double z, double r)
+{
+  c[0] = x; c[1] = y; c[2] = z;
+  this->r = r;
+}
+
+void CSphere::bounds(double *b0, double *b1) const
+{
+  for(int i = 0; i < 3; i++) {
+    b0[i] = c[i] - r;
+    b1[i] = c[i] + r;
+  }
+}
+
+int CSphere::crossings(int axis, const double *p, double *t) const
+{
+  double d2 = r * r;
+  for(int i = 0; i < 3; i++) if(i != axis) d2 -= (p[i] - c[i]) * (p[i] - c[i]);
+  if(d2 < 0.0) return 0;
+  double d = sqrt(d2);
+  t[0] = c[axis] - d;
+  t[1] = c[axis] + d;
+  return 2;
+}
+
+CCylinder::CCylinder(int a, double x, double y, double z, double r, double h)
+{
+  this->a = a;
+  c[0] = x; c[1] = y; c[2] = z;
+  this->r = r;
+  this->h = h;
+}
+
+void CCylinder::bounds(double *b0, double *b1) const
+{
+  for(int i = 0; i < 3; i++) {
+    double d = (i == a) ? 0.5 * h : r;
+    b0[i] = c[i] - d;
+    b1[i] = c[i] + d;
+  }
+}
+
+int CCylinder::crossings(int axis, const double *p, double *t) const
+{
+  if(axis == a) { // along the cylinder axis
+    double d2 = 0.0;
+    for(int i = 0; i < 3; i++) if(i != a) d2 += (p[i] - c[i]) * (p[i] - c[i]);
+    if(d2 > r * r) return 0;
+    t[0] = c[a] - 0.5 * h;
+    t[1] = c[a] + 0.5 * h;
+    return 2;
+  }
+  if(fabs(p[a] - c[a]) > 0.5 * h) return 0; // across the cylinder axis
+  int o = 3 - a - axis; // the other axis
+  double d2 = r * r - (p[o] - c[o]) * (p[o] - c[o]);
+  if(d2 < 0.0) return 0;
+  double d = sqrt(d2);
+  t[0] = c[axis] - d;
+  t[1] = c[axis] + d;
+  return 2;
+}
+
+CBox::CBox(double x0, double y0, double z0, double x1, double y1, double z1)
+{
+  b0[0] = x0; b0[1] = y0; b0[2] = z0;
+  b1[0] = x1; b1[1] = y1; b1[2] = z1;
+}
+
+void CBox::bounds(double *b0, double *b1) const
+{
+  for(int i = 0; i < 3; i++) {
+    b0[i] = this->b0[i];
+    b1[i] = this->b1[i];
+  }
+}
+
+int CBox::crossings(int axis, const double *p, double *t) const
+{
+  for(int i = 0; i < 3; i++)
+    if((i != axis) && ((p[i] < b0[i]) || (p[i] > b1[i]))) return 0;
+  t[0] = b0[axis];
+  t[1] = b1[axis];
+  return 2;
+}
+
+CExtrusion::CExtrusion(int a, const double *uv, size_t n, double h0, double h1)
+{
+  this->a = a;
+  this->h0 = h0;
+  this->h1 = h1;
+  for(size_t i = 0; i < n; i++) {
+    u.push_back(uv[2 * i]);
+    v.push_back(uv[2 * i + 1]);
+  }
+  int ia = (a + 1) % 3;
+  int ib = (a + 2) % 3;
+  b0[a] = h0; b1[a] = h1;
+  b0[ia] = *std::min_element(u.begin(), u.end());
+  b1[ia] = *std::max_element(u.begin(), u.end());
+  b0[ib] = *std::min_element(v.begin(), v.end());
+  b1[ib] = *std::max_element(v.begin(), v.end());
+}
+
+void CExtrusion::bounds(double *b0, double *b1) const
+{
+  for(int i = 0; i < 3; i++) {
+    b0[i] = this->b0[i];
+    b1[i] = this->b1[i];
+  }
+}
+
+int CExtrusion::crossings(int axis, const double *p, double *t) const
+{
+  int ia = (a + 1) % 3;
+  int ib = (a + 2) % 3;
+  if(axis == a) { // along the extrusion: inside the polygon?
+    double q[3];
+    q[ia] = p[ia]; q[ib] = p[ib]; q[a] = 0.5 * (h0 + h1);
+    double s[MAX_CROSSINGS];
+    int n = crossings(ia, q, s);
+    int m = 0;
+    while((m < n) && (s[m] <= p[ia])) m++;
+    if((m & 1) == 0) return 0;
+    t[0] = h0;
+    t[1] = h1;
+    return 2;
+  }
+  if((p[a] < h0) || (p[a] > h1)) return 0;
+
+  // across the extrusion: polygon edges crossing the line (half open rule)
+  const std::vector<double> &pu = (axis == ia) ? u : v; // along the line
+  const std::vector<double> &pv = (axis == ia) ? v : u;
+  double y = p[(axis == ia) ? ib : ia];
+  size_t nv = pu.size();
+  int n = 0;
+  for(size_t i = 0; (i < nv) && (n < MAX_CROSSINGS); i++) {
+    size_t j = (i + 1) % nv;
+    if((pv[i] <= y) == (pv[j] <= y)) continue;
+    t[n++] = pu[i] + (y - pv[i]) * (pu[j] - pu[i]) / (pv[j] - pv[i]);
+  }
+  std::sort(t, t + n);
+  return n & ~1;
+}
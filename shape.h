@@ -0,0 +1,91 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include <vector>
+
+#define MAX_CROSSINGS 256 // per line
+
+// shapes in grid units, node (i, j, k) at (i, j, k)
+class CShape
+{
+public:
+  virtual ~CShape() {}
+  virtual void bounds(double *b0, double *b1) const = 0; // bounding box
+  // sorted surface crossings of the axis aligned line through p
+  // (p[axis] is ignored), inside between crossing pairs
+  virtual int crossings(int axis, const double *p, double *t) const = 0;
+  bool inside(const double *p) const;
+  double outside(int axis, const double *p) const; // unit edge from p
+};
+
+class CSphere : public CShape
+{
+public:
+  CSphere(double x, double y, double z, double r);
+  void bounds(double *b0, double *b1) const;
+  int crossings(int axis, const double *p, double *t) const;
+private:
+  double c[3], r;
+};
+
+// a disk is a short cylinder, a 2D disk a long one along z
+class CCylinder : public CShape
+{
+public:
+  CCylinder(int a, double x, double y, double z, double r, double h);
+  void bounds(double *b0, double *b1) const;
+  int crossings(int axis, const double *p, double *t) const;
+private:
+  int a;       // cylinder axis (0, 1, 2)
+  double c[3], r, h; // centre, radius & length
+};
+
+class CBox : public CShape
+{
+public:
+  CBox(double x0, double y0, double z0, double x1, double y1, double z1);
+  void bounds(double *b0, double *b1) const;
+  int crossings(int axis, const double *p, double *t) const;
+private:
+  double b0[3], b1[3];
+};
+
+// polygon (any simple polygon) extruded along an axis
+// vertices are in the (a + 1, a + 2) plane, e.g. (y, z) for a = 0
+class CExtrusion : public CShape
+{
+public:
+  CExtrusion(int a, const double *uv, size_t n, double h0, double h1);
+  void bounds(double *b0, double *b1) const;
+  int crossings(int axis, const double *p, double *t) const;
+private:
+  int a;       // extrusion axis (0, 1, 2)
+  std::vector<double> u, v; // polygon vertices
+  double h0, h1; // extent along the axis
+  double b0[3], b1[3];
+};
+
+#endif // SHAPE_H
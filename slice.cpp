@@ -0,0 +1,123 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include "slice.h"
+
+// NOTES:
+//  1) nearest texel filtering, so each cell shows as one flat color (as the
+//     points); the quad & mesh run between cell centres, texel centres mapped
+//  2) transparent cells are cut by the alpha test, as the point cloud
+
+CSlice::CSlice(size_t sw, size_t sh)
+{
+  w = sw;
+  h = sh;
+  vertex = new float[3 * w * h];
+  color = new unsigned char[4 * w * h];
+  texcoord = new float[2 * w * h];
+  index = new GLuint[6 * (w - 1) * (h - 1)];
+  for(size_t i = 0; i < 3 * w * h; i++) vertex[i] = 0.0;
+  for(size_t i = 0; i < 4 * w * h; i++) color[i] = 0;
+  for(size_t v = 0; v < h; v++) {
+    for(size_t u = 0; u < w; u++) {
+      texcoord[2 * (u + v * w)] = (u + 0.5) / w;
+      texcoord[2 * (u + v * w) + 1] = (v + 0.5) / h;
+    }
+  }
+  GLuint *t = index;
+  for(size_t v = 0; v < h - 1; v++) {
+    for(size_t u = 0; u < w - 1; u++) {
+      GLuint n = u + v * w;
+      t[0] = n; t[1] = n + 1; t[2] = n + w + 1;
+      t[3] = n; t[4] = n + w + 1; t[5] = n + w;
+      t += 6;
+    }
+  }
+  ckey = -1;
+  cview = 0;
+  calpha = 0.0;
+  changed = true;
+  gl = false;
+  tex = 0;
+}
+
+CSlice::~CSlice()
+{
+  if(gl) glDeleteTextures(1, &tex);
+  delete[] vertex;
+  delete[] color;
+  delete[] texcoord;
+  delete[] index;
+}
+
+void CSlice::init_gl()
+{
+  gl = true;
+  glGenTextures(1, &tex);
+  glBindTexture(GL_TEXTURE_2D, tex);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, color);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  changed = false;
+}
+
+void CSlice::draw(bool mesh)
+{
+  if(!gl) init_gl();
+  glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+  glDisable(GL_LIGHTING);
+  glDisable(GL_CULL_FACE); // seen from either side
+  glAlphaFunc(GL_GREATER, 0.0);
+  glEnable(GL_ALPHA_TEST);
+  glEnable(GL_TEXTURE_2D);
+  glBindTexture(GL_TEXTURE_2D, tex);
+  glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+  if(changed) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, color);
+    changed = false;
+  }
+  if(mesh) {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertex);
+    glTexCoordPointer(2, GL_FLOAT, 0, texcoord);
+    glDrawElements(GL_TRIANGLES, 6 * (w - 1) * (h - 1), GL_UNSIGNED_INT, index);
+  }
+  else {
+    const size_t corner[4] = {0, w - 1, w * h - 1, (h - 1) * w};
+    glBegin(GL_QUADS);
+    for(int c = 0; c < 4; c++) {
+      glTexCoord2fv(texcoord + 2 * corner[c]);
+      glVertex3fv(vertex + 3 * corner[c]);
+    }
+    glEnd();
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glPopClientAttrib();
+  glPopAttrib();
+}
@@ -0,0 +1,57 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef SLICE_H
+#define SLICE_H
+
+#include <QtOpenGL>
+#include <stdlib.h>
+
+// a planar field section (w x h cells) drawn as one textured quad, or as a
+// heightfield mesh (surface), the texture holds a color per cell
+// no OpenGL calls before the first draw(), so it can be built off the GUI thread
+// the owner sets the vertex grid once, then colors (& heights) from field values
+class CSlice
+{
+public:
+  CSlice(size_t w, size_t h);
+  ~CSlice();
+
+  size_t w, h;           // cells (texels)
+  float *vertex;         // xyz per cell, row major (u fastest)
+  unsigned char *color;  // rgba per cell
+  int ckey;              // color state (owner defined, -1 = none)
+  unsigned int cview;    // color state: field values (owner defined serial)
+  double calpha;         // color state: alpha factor
+  bool changed;          // colors changed (uploaded by the next draw)
+
+  void draw(bool mesh);  // mesh: all vertices, else the corner ones (a quad)
+
+private:
+  void init_gl();
+  bool gl;               // texture created? (on the first draw)
+  GLuint tex;
+  float *texcoord;       // texel centres per vertex
+  GLuint *index;         // mesh triangles
+};
+
+#endif // SLICE_H
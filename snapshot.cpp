@@ -0,0 +1,65 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include "snapshot.h"
+
+// NOTES:
+//  1) three buffers: the writer's, the reader's and a middle one that is swapped
+//     atomically with either side, so a slow reader only skips frames
+//  2) a plain double buffer would need a lock (or a wait) to keep the writer
+//     off the buffer being drawn
+
+#define FRESH 4
+
+CSnapshot::CSnapshot(size_t n)
+{
+  size = n;
+  for(int i = 0; i < 3; i++) {
+    buf[i] = new float[size];
+    for(size_t j = 0; j < size; j++) buf[i][j] = 0.0;
+  }
+  wi = 0;
+  ri = 1;
+  state = 2;
+}
+
+CSnapshot::~CSnapshot()
+{
+  for(int i = 0; i < 3; i++) delete[] buf[i];
+}
+
+void CSnapshot::publish()
+{
+  wi = state.fetchAndStoreOrdered(wi | FRESH) & 3;
+}
+
+const float *CSnapshot::front()
+{
+  if(state & FRESH) ri = state.fetchAndStoreOrdered(ri) & 3;
+  return buf[ri];
+}
+
+bool CSnapshot::fresh() const
+{
+  return (state & FRESH) != 0;
+}
@@ -0,0 +1,52 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <QAtomicInt>
+#include <stdlib.h>
+
+// lock-free triple buffered display field (one writer, one reader)
+// the writer fills back() then publish()es it, the reader takes front()
+// neither side ever waits; the reader always gets the latest complete buffer
+class CSnapshot
+{
+public:
+  CSnapshot(size_t n);
+  ~CSnapshot();
+
+  size_t size;
+
+  float *back() {return buf[wi];} // writer (solver thread)
+  void publish();
+  const float *front();           // reader (GUI thread)
+  bool fresh() const;             // unread buffer published?
+
+private:
+  float *buf[3];
+  int wi, ri;       // owned by writer & reader
+  QAtomicInt state; // middle buffer index | FRESH
+};
+
+#endif // SNAPSHOT_H
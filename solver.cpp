@@ -0,0 +1,96 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <QTime>
+#include <QMutexLocker>
+
+#include "model.h"
+#include "snapshot.h"
+#include "replay.h"
+#include "solver.h"
+#include "profiler.h"
+
+// NOTES:
+//  1) the model is only stepped and snapped here, drawing only reads snapshots
+//  2) at most one snapshot per frame period, intermediate steps are not copied
+
+#define FRAME_PERIOD 40 // snapshot period (ms)
+#define IDLE_PERIOD 10  // poll period when not running (ms)
+
+CSolver::CSolver(CModel *m, CSnapshot *s)
+{
+  model = m;
+  snapshot = s;
+  running = false;
+  period = 0;
+  step_ms = 0;
+  steps = 0;
+  replay = NULL;
+  quit = false;
+}
+
+CSolver::~CSolver()
+{
+  quit = true;
+  wait();
+}
+
+void CSolver::refresh()
+{
+  QMutexLocker locker(&lock);
+  model->snap(snapshot->back());
+  snapshot->publish();
+}
+
+void CSolver::run()
+{
+  QTime frame, step;
+  frame.start();
+#ifdef PROFILE_COUNTERS
+  profiler.attach_counters(); // this thread steps the model
+#endif
+  while(!quit) {
+    if(!running) {
+      msleep(IDLE_PERIOD);
+      continue;
+    }
+    step.start();
+    lock.lock();
+    if(!running) { // stopped while waiting for the lock
+      lock.unlock();
+      continue;
+    }
+    model->step();
+    steps.ref();
+    if(frame.elapsed() >= FRAME_PERIOD) {
+      model->snap(snapshot->back());
+      if(replay != NULL) replay->record(snapshot->back(), model->field_type);
+      snapshot->publish();
+      frame.restart();
+    }
+    lock.unlock();
+    int t = step.elapsed();
+    step_ms = t;
+    if(t < period) msleep(period - t);
+  }
+}
@@ -0,0 +1,61 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+
+class CModel;
+class CSnapshot;
+class CReplay;
+
+// steps a model on its own thread, publishing display snapshots at frame rate
+// anything that changes model state from the GUI thread must hold lock
+class CSolver : public QThread
+{
+public:
+  CSolver(CModel *m, CSnapshot *s);
+  ~CSolver();
+
+  QMutex lock;            // held for each model step
+  volatile bool running;  // stepping?
+  volatile int period;    // minimum step period (ms)
+  QAtomicInt step_ms;     // last step time (ms)
+  QAtomicInt steps;       // steps taken (for steps/s)
+  CReplay *replay;        // published snapshots recorded (NULL: none)
+
+  void refresh();         // publish a snapshot now (GUI thread)
+
+protected:
+  void run();
+
+private:
+  CModel *model;
+  CSnapshot *snapshot;
+  volatile bool quit;
+};
+
+#endif // SOLVER_H
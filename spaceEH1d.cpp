@@ -35,6 +35,8 @@ CSpaceEH1d::CSpaceEH1d(size_t s)
 CSpaceEH1d::~CSpaceEH1d()
 {
   delete[] c;
+  delete[] eMax;
+  delete[] eMin;
 }
 
 void CSpaceEH1d::reset()
@@ -23,6 +23,7 @@ rugis@msu.edu
 #include "utils.h"
 #include "cell2d.h"
 #include "spaceEH2d.h"
+#include "parallel.h"
 
 CSpaceEH2d::CSpaceEH2d(size_t sx, size_t sy)
 {
@@ -30,8 +31,6 @@ CSpaceEH2d::CSpaceEH2d(size_t sx, size_t sy)
   sY = sy;
   sXY = sx * sy;
   c = new Ccell2d[sXY];  // EH cells
-  d = new double[3 * sXY];   // dither values
-
 }
 
 CSpaceEH2d::~CSpaceEH2d()
@@ -41,8 +40,14 @@ CSpaceEH2d::~CSpaceEH2d()
 
 void CSpaceEH2d::reset()
 {
-  for(size_t i = 0; i < sXY; i++) c[i].reset();
-  for(size_t i = 0; i < 3 * sXY; i++) d[i] = randpm();
+  class CReset : public CLoop { // fields only (coefficients kept)
+  public:
+    CReset(Ccell2d *c) : c(c) {}
+    void run(long first, long last) {for(long i = first; i < last; i++) c[i].reset();}
+  private:
+    Ccell2d *c;
+  } cells(c);
+  parallelFor(sXY, cells);
 }
 
 void CSpaceEH2d::update_e() // calculated using Ez Hx Hy
@@ -36,7 +36,6 @@ public:
   size_t sX, sY;  // size
   size_t sXY;  // size
   Ccell2d *c; // EH cells
-  double *d;  // dither values
 
   void reset();
   void update_e();
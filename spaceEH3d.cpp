@@ -26,6 +26,7 @@ rugis@msu.edu
 #include "utils.h"
 #include "cell3d.h"
 #include "spaceEH3d.h"
+#include "parallel.h"
 
 CSpaceEH3d::CSpaceEH3d(size_t sx, size_t sy, size_t sz)
 {
@@ -35,63 +36,6 @@ CSpaceEH3d::CSpaceEH3d(size_t sx, size_t sy, size_t sz)
   sXY = sx * sy;
   sXYZ = sx * sy * sz;
   c = new Ccell3d[sXYZ];  // EH cells
-  d = new double[3 * sXYZ];   // dither values
-  YeeCell = glGenLists(1);
-  glNewList(YeeCell, GL_COMPILE);
-    glLineWidth(2.0);
-    glPointSize(6.0);
-    glColor4d(MIDGREY, 0.5);
-    glBegin(GL_LINE_LOOP);
-      glVertex3d( 0.0, 0.0, 0.0);
-      glVertex3d( 0.5, 0.0, 0.0);
-      glVertex3d( 0.5, 0.5, 0.0);
-      glVertex3d( 0.0, 0.5, 0.0);
-    glEnd();
-    glBegin(GL_LINE_LOOP);
-      glVertex3d( 0.0, 0.0, 0.5);
-      glVertex3d( 0.5, 0.0, 0.5);
-      glVertex3d( 0.5, 0.5, 0.5);
-      glVertex3d( 0.0, 0.5, 0.5);
-    glEnd();
-    glBegin(GL_LINES);
-      glVertex3d( 0.0, 0.0, 0.0);
-      glVertex3d( 0.0, 0.0, 0.5);
-      glVertex3d( 0.5, 0.0, 0.0);
-      glVertex3d( 0.5, 0.0, 0.5);
-      glVertex3d( 0.5, 0.5, 0.0);
-      glVertex3d( 0.5, 0.5, 0.5);
-      glVertex3d( 0.0, 0.5, 0.0);
-      glVertex3d( 0.0, 0.5, 0.5);
-    glEnd();
-    glColor4d(MIDYELLOW, 1.0);
-    glBegin(GL_LINES);
-      glVertex3d( 0.45, 0.0, 0.0);
-      glVertex3d( 0.55, 0.0, 0.0);
-      glVertex3d( 0.0, 0.45, 0.0);
-      glVertex3d( 0.0, 0.55, 0.0);
-      glVertex3d( 0.0, 0.0, 0.45);
-      glVertex3d( 0.0, 0.0, 0.55);
-    glEnd();
-    glBegin(GL_POINTS);
-      glVertex3d( 0.45, 0.0, 0.0);
-      glVertex3d( 0.0, 0.45, 0.0);
-      glVertex3d( 0.0, 0.0, 0.45);
-    glEnd();
-    glColor4d(MIDCYAN, 1.0);
-    glBegin(GL_LINES);
-      glVertex3d(-0.05, 0.5, 0.5);
-      glVertex3d(0.05, 0.5, 0.5);
-      glVertex3d(0.5, -0.05, 0.5);
-      glVertex3d(0.5, 0.05, 0.5);
-      glVertex3d(0.5, 0.5, -0.05);
-      glVertex3d(0.5, 0.5, 0.05);
-    glEnd();
-    glBegin(GL_POINTS);
-      glVertex3d(-0.05, 0.5, 0.5);
-      glVertex3d(0.5, -0.05, 0.5);
-      glVertex3d(0.5, 0.5, -0.05);
-    glEnd();
-  glEndList();
 }
 
 CSpaceEH3d::~CSpaceEH3d()
@@ -101,16 +45,16 @@ CSpaceEH3d::~CSpaceEH3d()
 
 void CSpaceEH3d::reset()
 {
-  for(size_t i = 0; i < sXYZ; i++) c[i].reset();
-  for(size_t i = 0; i < 3 * sXYZ; i++) d[i] = randpm();
+  class CReset : public CLoop { // fields only (coefficients kept)
+  public:
+    CReset(Ccell3d *c) : c(c) {}
+    void run(long first, long last) {for(long i = first; i < last; i++) c[i].reset();}
+  private:
+    Ccell3d *c;
+  } cells(c);
+  parallelFor(sXYZ, cells);
 }
 
-void CSpaceEH3d::draw_yee()
-{
-  glCallList(YeeCell);
-}
-
-
 void CSpaceEH3d::update_e()
 {
   for (size_t k = 1; k < sZ - 1; k++) { // don't update boundary e-fields
@@ -23,7 +23,6 @@ rugis@msu.edu
 #ifndef SPACEEH3D_H
 #define SPACEEH3D_H
 
-#include <QtOpenGL>
 #include <stdlib.h>
 
 class Ccell3d;
@@ -37,13 +36,10 @@ public:
   size_t sX, sY, sZ;  // size
   size_t sXY, sXYZ;  // size
   Ccell3d *c; // EH cells
-  double *d;  // dither values
-  GLuint YeeCell;
 
   void reset();
   void update_e();
   void update_h();
-  void draw_yee();
 };
 
 #endif // SPACEEH3D_H
@@ -0,0 +1,204 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <math.h>
+
+#include "defs.h"
+#include "cell3d.h"
+#include "spaceEH3d.h"
+#include "subgrid3d.h"
+
+// NOTES:
+//  1) region corners are coarse cell indices, i0 < i1 etc.
+//  2) dt and dx both scale by 1/ratio so update coefficients copy unchanged
+//     (lossy material coefficients are per time-step and would need rescaling)
+//  3) the e-field coupling is not energy conserving, so it is only weakly stable:
+//     in a closed (lossless) cavity energy slowly grows after ~10000 steps
+//     (ratios 2 & 3) or ~2000 steps (ratio 5); use with an absorbing boundary
+//  4) only strictly interior coarse e-fields are restricted, averages that
+//     include the interpolated fine boundary go unstable within a few hundred steps
+
+CSubgrid3d::CSubgrid3d(CSpaceEH3d *s, size_t i0, size_t j0, size_t k0,
+                                      size_t i1, size_t j1, size_t k1, size_t r)
+{
+  c = s->c;
+  sx = s->sX;
+  sy = s->sY;
+  sz = s->sZ;
+  sxy = s->sXY;
+  ratio = r;
+  bx0 = i0; by0 = j0; bz0 = k0;
+  bx1 = i1; by1 = j1; bz1 = k1;
+
+  // stored coarse region: box plus one cell margin (for interpolation)
+  px0 = (bx0 > 0) ? bx0 - 1 : 0;
+  py0 = (by0 > 0) ? by0 - 1 : 0;
+  pz0 = (bz0 > 0) ? bz0 - 1 : 0;
+  px = ((bx1 + 2 < sx) ? bx1 + 2 : sx) - px0;
+  py = ((by1 + 2 < sy) ? by1 + 2 : sy) - py0;
+  pz = ((bz1 + 2 < sz) ? bz1 + 2 : sz) - pz0;
+  pex = new double[px * py * pz];
+  pey = new double[px * py * pz];
+  pez = new double[px * py * pz];
+
+  f = new CSpaceEH3d(ratio * (bx1 - bx0) + 1, ratio * (by1 - by0) + 1, ratio * (bz1 - bz0) + 1);
+
+  // fine material from the nearest coarse cell
+  for (size_t k = 0; k < f->sZ; k++) {
+    size_t ck = (bz0 * ratio + k + ratio / 2) / ratio;
+    if(ck > sz - 1) ck = sz - 1;
+    for (size_t j = 0; j < f->sY; j++) {
+      size_t cj = (by0 * ratio + j + ratio / 2) / ratio;
+      if(cj > sy - 1) cj = sy - 1;
+      for (size_t i = 0; i < f->sX; i++) {
+        size_t ci = (bx0 * ratio + i + ratio / 2) / ratio;
+        if(ci > sx - 1) ci = sx - 1;
+        Ccell3d *fc = &(f->c[i + j * f->sX + k * f->sXY]);
+        Ccell3d *cc = &(c[ci + cj * sx + ck * sxy]);
+        fc->cexe = cc->cexe; fc->cexh = cc->cexh;
+        fc->ceye = cc->ceye; fc->ceyh = cc->ceyh;
+        fc->ceze = cc->ceze; fc->cezh = cc->cezh;
+        fc->chxh = cc->chxh; fc->chxe = cc->chxe;
+        fc->chyh = cc->chyh; fc->chye = cc->chye;
+        fc->chzh = cc->chzh; fc->chze = cc->chze;
+      }
+    }
+  }
+}
+
+CSubgrid3d::~CSubgrid3d()
+{
+  delete f;
+  delete[] pex;
+  delete[] pey;
+  delete[] pez;
+}
+
+void CSubgrid3d::reset()
+{
+  f->reset();
+  for(size_t i = 0; i < px * py * pz; i++) pex[i] = pey[i] = pez[i] = 0.0;
+}
+
+void CSubgrid3d::store()
+{
+  for (size_t k = 0; k < pz; k++) {
+    for (size_t j = 0; j < py; j++) {
+      for (size_t i = 0; i < px; i++) {
+        size_t m = i + j * px + k * px * py;
+        size_t n = (px0 + i) + (py0 + j) * sx + (pz0 + k) * sxy;
+        pex[m] = c[n].ex;
+        pey[m] = c[n].ey;
+        pez[m] = c[n].ez;
+      }
+    }
+  }
+}
+
+void CSubgrid3d::update()
+{
+  for (size_t s = 1; s <= ratio; s++) { // fine time sub-steps
+    f->update_h();
+    f->update_e();
+    interpolate(double(s) / ratio);
+  }
+  restrict_e();
+}
+
+// trilinear (space) & linear (time) interpolation of a coarse e-field component
+//  x, y, z: position on the component lattice (coarse cell units)
+//  a: time fraction between stored (0.0) and current (1.0) coarse fields
+double CSubgrid3d::sample(int comp, double x, double y, double z, double a) const
+{
+  long i = long(floor(x));
+  long j = long(floor(y));
+  long k = long(floor(z));
+  double fx = x - i;
+  double fy = y - j;
+  double fz = z - k;
+  if(i < long(px0)) {i = px0; fx = 0.0;}
+  if(j < long(py0)) {j = py0; fy = 0.0;}
+  if(k < long(pz0)) {k = pz0; fz = 0.0;}
+  if(i > long(px0 + px - 2)) {i = px0 + px - 2; fx = 1.0;}
+  if(j > long(py0 + py - 2)) {j = py0 + py - 2; fy = 1.0;}
+  if(k > long(pz0 + pz - 2)) {k = pz0 + pz - 2; fz = 1.0;}
+
+  const double *p = (comp == 0) ? pex : ((comp == 1) ? pey : pez);
+  double v = 0.0;
+  for (int dk = 0; dk < 2; dk++) {
+    for (int dj = 0; dj < 2; dj++) {
+      for (int di = 0; di < 2; di++) {
+        double w = (di ? fx : 1.0 - fx) * (dj ? fy : 1.0 - fy) * (dk ? fz : 1.0 - fz);
+        size_t n = (i + di) + (j + dj) * sx + (k + dk) * sxy;
+        size_t m = (i + di - px0) + (j + dj - py0) * px + (k + dk - pz0) * px * py;
+        double e = (comp == 0) ? c[n].ex : ((comp == 1) ? c[n].ey : c[n].ez);
+        v += w * ((1.0 - a) * p[m] + a * e);
+      }
+    }
+  }
+  return v;
+}
+
+void CSubgrid3d::interpolate(double a) // set fine boundary e-fields
+{
+  double h = 0.5 / ratio - 0.5; // fine e-field offset on the coarse lattice
+  for (size_t k = 0; k < f->sZ; k++) {
+    bool zb = (k == 0) || (k == f->sZ - 1);
+    for (size_t j = 0; j < f->sY; j++) {
+      bool yb = (j == 0) || (j == f->sY - 1);
+      size_t di = (zb || yb) ? 1 : f->sX - 1; // boundary faces only
+      for (size_t i = 0; i < f->sX; i += di) {
+        size_t n = i + j * f->sX + k * f->sXY;
+        double x = bx0 + double(i) / ratio;
+        double y = by0 + double(j) / ratio;
+        double z = bz0 + double(k) / ratio;
+        f->c[n].ex = sample(0, x + h, y, z, a);
+        f->c[n].ey = sample(1, x, y + h, z, a);
+        f->c[n].ez = sample(2, x, y, z + h, a);
+      }
+    }
+  }
+}
+
+void CSubgrid3d::restrict_e() // coarse e-fields inside region from fine edge averages
+{
+  // region interior only: averages never include the (interpolated) fine boundary
+  double w = 1.0 / ratio;
+  for (size_t k = bz0 + 1; k < bz1; k++) {
+    for (size_t j = by0 + 1; j < by1; j++) {
+      for (size_t i = bx0 + 1; i < bx1; i++) {
+        size_t n = i + j * sx + k * sxy;
+        size_t m = (i - bx0) * ratio + (j - by0) * ratio * f->sX + (k - bz0) * ratio * f->sXY;
+        double ex, ey, ez;
+        ex = ey = ez = 0.0;
+        for (size_t q = 0; q < ratio; q++) {
+          ex += f->c[m + q].ex;
+          ey += f->c[m + q * f->sX].ey;
+          ez += f->c[m + q * f->sXY].ez;
+        }
+        c[n].ex = w * ex;
+        c[n].ey = w * ey;
+        c[n].ez = w * ez;
+      }
+    }
+  }
+}
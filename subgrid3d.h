@@ -0,0 +1,64 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef SUBGRID3D_H
+#define SUBGRID3D_H
+
+#include <stdlib.h>
+
+class Ccell3d;
+class CSpaceEH3d;
+
+// refined region embedded in a 3D space
+// the fine space has dx and dt reduced by the refinement ratio (same DTDS)
+// fine boundary e-fields are interpolated from the coarse space (space & time),
+// coarse e-fields inside the region are restricted from the fine space
+class CSubgrid3d
+{
+public:
+  CSubgrid3d(CSpaceEH3d *s, size_t i0, size_t j0, size_t k0,
+                            size_t i1, size_t j1, size_t k1, size_t r);
+  ~CSubgrid3d();
+
+  CSpaceEH3d *f;     // the fine space
+  size_t ratio;      // refinement ratio (2, 3, 5...)
+  size_t bx0, by0, bz0; // region in coarse cells
+  size_t bx1, by1, bz1;
+
+  void reset();
+  void store();      // before coarse e-field update
+  void update();     // after coarse e-field update (fine sub-steps)
+
+private:
+  Ccell3d *c;        // the coarse space
+  size_t sx, sy, sz; // size of coarse space
+  size_t sxy;
+  size_t px, py, pz; // size of stored coarse region
+  size_t px0, py0, pz0;
+  double *pex, *pey, *pez; // stored coarse e-fields (previous time level)
+
+  double sample(int comp, double x, double y, double z, double a) const;
+  void interpolate(double a);
+  void restrict_e();
+};
+
+#endif // SUBGRID3D_H
@@ -71,6 +71,12 @@ CTfsf2d::CTfsf2d(CSpaceEH2d *s, size_t sB, size_t sD)
   abc2o1d = new CAbc2o1d(a);
 }
 
+CTfsf2d::~CTfsf2d()
+{
+  delete abc2o1d;
+  delete a;
+}
+
 void CTfsf2d::reset()
 {
   a->reset();
@@ -33,6 +33,7 @@ class CTfsf2d
 {
 public:
   CTfsf2d(CSpaceEH2d *s, size_t sB, size_t sD);
+  ~CTfsf2d();
   void reset();
   void updateA();     // before source signal update
   void updateB();     // after source signal update
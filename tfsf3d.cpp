@@ -81,6 +81,12 @@ CTfsf3d::CTfsf3d(CSpaceEH3d *s, size_t sB, size_t sD)
   abc2o1d = new CAbc2o1d(a);
 }
 
+CTfsf3d::~CTfsf3d()
+{
+  delete abc2o1d;
+  delete a;
+}
+
 void CTfsf3d::reset()
 {
   a->reset();
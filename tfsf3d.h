@@ -33,6 +33,7 @@ class CTfsf3d
 {
 public:
   CTfsf3d(CSpaceEH3d *s, size_t sB, size_t sD);
+  ~CTfsf3d();
   void reset();
   void updateA();      // before source signal update
   void updateB();      // after source signal update
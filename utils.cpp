@@ -156,14 +156,16 @@ void show_help()
   QMessageBox::about(0, "",
     "GL_10 v1.0\n"
     "Keypress Commands\n\n"
+    "1 2 3  model dimension (switching keeps fields)\n"
     "+   increase point size\n"
+    "[ ]  replay back/forward (pauses)\n"
     "-   decrease point size\n"
     "A   animated rotation run/pause\n"
     "a   axis display toggle\n"
     "B   display boundary (3D) toggle\n"
     "b   bounding box display toggle\n"
     "c   cycle (2D) surface/flat/line\n"
-    "c   cycle (3D) full/half/slice/surface/line\n"
+    "c   cycle (3D) full/half/slice/surface/line/iso\n"
     "d   dither points (2D/3D) toggle\n"
     "F   field cycle (1D) Ez/Ez peak/Hy/EzHy\n"
     "F   field cycle (3D) Ex/Ey/Ez/Exyz\n"
@@ -172,7 +174,9 @@ void show_help()
     "K   thin (3D) points\n"
     "k   restore (3D) points\n"
     "L   license information\n"
+    "M   full speed (adaptive frame skipping) toggle\n"
     "o   orthogonal projection toggle\n"
+    "P   write step profile (profile.json, profile.csv)\n"
     "Q   increase alpha (2D/3D)\n"
     "q   decrease alpha (2D/3D)\n"
     "R   reset simulation\n"
@@ -180,6 +184,7 @@ void show_help()
     "S   stereo display toggle\n"
     "s   slower simulation update\n"
     "T   time display draw\n"
+    "W   write isosurface (3D, isosurface.obj)\n"
     "t    time field calculation\n"
     "Y   yee cell display toggle (3D)\n"
     "X   exit\n"
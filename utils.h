@@ -44,6 +44,18 @@ void HSVtoRGB(HSV *phsl, RGB *prgb);
 
 void randinit();
 double randpm();
+
+// dither offset [-0.5, 0.5) for a cell & axis: a counter-based hash of
+// (cell, axis, key), stateless so cells can be dithered in any order & thread
+inline double dither(size_t n, int axis, unsigned int key)
+{
+  unsigned long long x = ((((unsigned long long)n) << 2) | axis) + (((unsigned long long)key) << 48);
+  x += 0x9e3779b97f4a7c15ULL; // splitmix64
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return (x >> 11) * (1.0 / 9007199254740992.0) - 0.5;
+}
 void fatalError(QString message);
 void popupMessage(QString title, QString message);
 void show_splash(QWidget *p);
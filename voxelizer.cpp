@@ -0,0 +1,237 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#include <math.h>
+
+#include "defs.h"
+#include "cell2d.h"
+#include "cell3d.h"
+#include "spaceEH2d.h"
+#include "spaceEH3d.h"
+#include "geometry3d.h"
+#include "shape.h"
+#include "voxelizer.h"
+#include "parallel.h"
+
+// NOTES:
+//  1) only rows crossing the shape bounding box are visited, rows are
+//     independent (thread pool ranges)
+//  2) blending recovers (scaled) permittivity & loss from the current
+//     coefficients, so shapes can be layered on any background
+//  3) fill shapes before any conformal object, tfsf or abc is set
+
+CMaterial::CMaterial(double epsr, double loss, bool pec)
+{
+  this->epsr = epsr;
+  this->loss = loss;
+  this->pec = pec;
+}
+
+CVoxelizer::CVoxelizer(int ss)
+{
+  this->ss = (ss < 1) ? 1 : ss;
+}
+
+// blend material into e-field coefficients by fill fraction f
+//  q0: free-space (scaled) permittivity 1 / (DTDS * IMP0)
+static void blend(double &ce, double &ch, double f, const CMaterial &m, double q0)
+{
+  if(f <= 0.0) return;
+  if(m.pec) {
+    if(f >= 0.5) ce = ch = 0.0;
+    return;
+  }
+  if(ch == 0.0) return; // already pec
+  if(f > 1.0) f = 1.0;
+  double q = 0.5 * (1.0 + ce) / ch;           // current permittivity
+  double s = q * (1.0 - ce) / (1.0 + ce);     // current loss
+  q = f * m.epsr * q0 + (1.0 - f) * q;
+  s = f * m.epsr * q0 * m.loss + (1.0 - f) * s;
+  double l = s / q;
+  ce = (1.0 - l) / (1.0 + l);
+  ch = 1.0 / (q * (1.0 + l));
+}
+
+// fill fractions of the row of dual cells centred at p + (i, 0, 0)
+//  ny, nz: sub-rows across the row (1: single line through p)
+//  f: accumulated fill fractions, i0 & i1: range of cells touched
+bool CVoxelizer::row(const CShape *shape, const double *p, int ny, int nz,
+                     size_t sx, double *f, size_t &i0, size_t &i1) const
+{
+  double t[MAX_CROSSINGS];
+  double w = 1.0 / (ny * nz);
+  bool hit = false;
+  for (int qz = 0; qz < nz; qz++) {
+    for (int qy = 0; qy < ny; qy++) {
+      double q[3] = {0.0, p[1], p[2]};
+      if(ny > 1) q[1] += (qy + 0.5) / ny - 0.5;
+      if(nz > 1) q[2] += (qz + 0.5) / nz - 0.5;
+      int n = shape->crossings(0, q, t);
+      for (int m = 0; m + 1 < n; m += 2) {
+        double c0 = t[m] - p[0] + 0.5; // in cell units
+        double c1 = t[m + 1] - p[0] + 0.5;
+        if((c1 <= 0.0) || (c0 >= sx)) continue;
+        if(c0 < 0.0) c0 = 0.0;
+        if(c1 > sx) c1 = sx;
+        size_t ia = size_t(c0);
+        size_t ib = size_t(c1);
+        if(ib > sx - 1) ib = sx - 1;
+        for (size_t i = ia; i <= ib; i++) { // scanline
+          double a = (c0 > i) ? c0 : i;
+          double b = (c1 < i + 1.0) ? c1 : i + 1.0;
+          if(b > a) f[i] += w * (b - a);
+        }
+        if(!hit || (ia < i0)) i0 = ia;
+        if(!hit || (ib > i1)) i1 = ib;
+        hit = true;
+      }
+    }
+  }
+  return hit;
+}
+
+// row range [r0, r1] of dual cells (centred at o + r) meeting [b0, b1]
+static void row_range(double b0, double b1, double o, size_t s, long &r0, long &r1)
+{
+  r0 = long(ceil(b0 - o - 0.5));
+  r1 = long(floor(b1 - o + 0.5));
+  if(r0 < 0) r0 = 0;
+  if(r1 > long(s) - 1) r1 = long(s) - 1;
+}
+
+// rows of one fill, on the thread pool (each range has its own fractions)
+class CVoxelRows : public CLoop
+{
+public:
+  CVoxelRows(const CVoxelizer *v, const CShape *shape) : v(v), shape(shape) {
+    s3 = NULL; s2 = NULL; g = NULL; mi = NULL;
+    a = 0; ny = nz = v->ss; j0 = k0 = 0; nj = 1; index = 0; q0 = 0.0;
+    o[0] = o[1] = o[2] = 0.0;
+  }
+  void run(long first, long last);
+
+  const CVoxelizer *v;
+  const CShape *shape;
+  CSpaceEH3d *s3;       // one of: 3D space,
+  CSpaceEH2d *s2;       //   2D space,
+  CGeometry3d *g;       //   or geometry (material indices mi)
+  unsigned char *mi;
+  unsigned char index;
+  CMaterial m;
+  double q0;            // free-space (scaled) permittivity
+  int a, ny, nz;        // e-field component, sub-rows
+  double o[3];          // component offset
+  long j0, k0, nj;      // first row, rows per k
+};
+
+void CVoxelRows::run(long first, long last)
+{
+  size_t sx = s3 ? s3->sX : (s2 ? s2->sX : g->sX);
+  double *f = new double[sx];
+  for (size_t i = 0; i < sx; i++) f[i] = 0.0;
+  for (long r = first; r < last; r++) {
+    size_t j = j0 + r % nj;
+    size_t k = k0 + r / nj;
+    double p[3] = {o[0], j + o[1], k + o[2]};
+    size_t i0, i1;
+    if(!v->row(shape, p, ny, nz, sx, f, i0, i1)) continue;
+    for (size_t i = i0; i <= i1; i++) {
+      if(s3 != NULL) {
+        Ccell3d &c = s3->c[i + j * sx + k * s3->sXY];
+        if(a == 0) blend(c.cexe, c.cexh, f[i], m, q0);
+        else if(a == 1) blend(c.ceye, c.ceyh, f[i], m, q0);
+        else blend(c.ceze, c.cezh, f[i], m, q0);
+      }
+      else if(s2 != NULL) {
+        Ccell2d &c = s2->c[i + j * sx];
+        blend(c.cee, c.ceh, f[i], m, q0);
+      }
+      else if(f[i] >= 0.5) mi[i + j * sx + k * g->sXY] = index;
+      f[i] = 0.0;
+    }
+  }
+  delete[] f;
+}
+
+void CVoxelizer::fill(CSpaceEH3d *s, const CShape *shape, const CMaterial &m) const
+{
+  double b0[3], b1[3];
+  shape->bounds(b0, b1);
+  CVoxelRows rows(this, shape);
+  rows.s3 = s;
+  rows.m = m;
+  rows.q0 = 1.0 / (DTDS3D * IMP0);
+  for (int a = 0; a < 3; a++) { // e-field component (ex, ey, ez)
+    rows.a = a;
+    rows.o[0] = rows.o[1] = rows.o[2] = 0.0;
+    rows.o[a] = 0.5;
+    long j0, j1, k0, k1;
+    row_range(b0[1], b1[1], rows.o[1], s->sY, j0, j1);
+    row_range(b0[2], b1[2], rows.o[2], s->sZ, k0, k1);
+    if((j1 < j0) || (k1 < k0)) continue;
+    rows.j0 = j0;
+    rows.k0 = k0;
+    rows.nj = j1 - j0 + 1;
+    parallelFor(rows.nj * (k1 - k0 + 1), rows);
+  }
+}
+
+void CVoxelizer::fill(CSpaceEH2d *s, const CShape *shape, const CMaterial &m) const
+{
+  double b0[3], b1[3];
+  shape->bounds(b0, b1);
+  if((b0[2] > 0.0) || (b1[2] < 0.0)) return; // the 2D space is at z = 0
+  CVoxelRows rows(this, shape);
+  rows.s2 = s;
+  rows.m = m;
+  rows.q0 = 1.0 / (DTDS2D * IMP0);
+  rows.nz = 1; // e-field at the nodes
+  long j0, j1;
+  row_range(b0[1], b1[1], 0.0, s->sY, j0, j1);
+  if(j1 < j0) return;
+  rows.j0 = j0;
+  rows.nj = j1 - j0 + 1;
+  parallelFor(rows.nj, rows);
+}
+
+void CVoxelizer::fill(CGeometry3d *g, const CShape *shape, unsigned char index) const
+{
+  double b0[3], b1[3];
+  shape->bounds(b0, b1);
+  CVoxelRows rows(this, shape);
+  rows.g = g;
+  rows.index = index;
+  for (int a = 0; a < 3; a++) { // e-field component (ex, ey, ez)
+    rows.mi = (a == 0) ? g->mx : ((a == 1) ? g->my : g->mz);
+    rows.o[0] = rows.o[1] = rows.o[2] = 0.0;
+    rows.o[a] = 0.5;
+    long j0, j1, k0, k1;
+    row_range(b0[1], b1[1], rows.o[1], g->sY, j0, j1);
+    row_range(b0[2], b1[2], rows.o[2], g->sZ, k0, k1);
+    if((j1 < j0) || (k1 < k0)) continue;
+    rows.j0 = j0;
+    rows.k0 = k0;
+    rows.nj = j1 - j0 + 1;
+    parallelFor(rows.nj * (k1 - k0 + 1), rows);
+  }
+}
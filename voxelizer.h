@@ -0,0 +1,64 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+
+#ifndef VOXELIZER_H
+#define VOXELIZER_H
+
+#include <stdlib.h>
+
+class CSpaceEH2d;
+class CSpaceEH3d;
+class CGeometry3d;
+class CShape;
+class CVoxelRows;
+
+class CMaterial
+{
+public:
+  CMaterial(double epsr = 1.0, double loss = 0.0, bool pec = false);
+  double epsr; // relative permittivity
+  double loss; // e-field loss factor (per time-step)
+  bool pec;    // perfect electric conductor
+};
+
+// scanline shape rasterizer for the material (e-field) coefficients
+// each e-field component is filled over its own (dual) cell: the fill
+// fraction is the average over ss x ss sub-rows of the exact covered length,
+// permittivity and loss are averaged by fill fraction at interfaces,
+// pec components (and material indices) are set at a fill fraction of one
+// half or more
+class CVoxelizer
+{
+public:
+  CVoxelizer(int ss = 4);
+  void fill(CSpaceEH3d *s, const CShape *shape, const CMaterial &m) const;
+  void fill(CSpaceEH2d *s, const CShape *shape, const CMaterial &m) const;
+  void fill(CGeometry3d *g, const CShape *shape, unsigned char index) const;
+private:
+  friend class CVoxelRows;
+  int ss; // sub-rows per axis
+  bool row(const CShape *shape, const double *p, int ny, int nz,
+           size_t sx, double *f, size_t &i0, size_t &i1) const;
+};
+
+#endif // VOXELIZER_H
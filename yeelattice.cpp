@@ -0,0 +1,143 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#include <string.h>
+
+#include "defs.h"
+#include "yeelattice.h"
+
+// NOTES:
+//  1) one cell glyph per lattice point, in cell units from the lattice point:
+//     grey edges, yellow e-field & cyan h-field component positions
+//  2) the glyph count is kept under YEE_BUDGET by thinning the lattice
+//     (the owner's skip is the least stride), so drawing is two draw calls
+//     of 42 vertices per glyph whatever the grid size
+
+#define YEE_BUDGET 20000 // most glyphs
+
+static const float yee_lines[][3] = { // grey edges (two loops & the uprights)
+  {0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}, {0.5, 0.0, 0.0}, {0.5, 0.5, 0.0},
+  {0.5, 0.5, 0.0}, {0.0, 0.5, 0.0}, {0.0, 0.5, 0.0}, {0.0, 0.0, 0.0},
+  {0.0, 0.0, 0.5}, {0.5, 0.0, 0.5}, {0.5, 0.0, 0.5}, {0.5, 0.5, 0.5},
+  {0.5, 0.5, 0.5}, {0.0, 0.5, 0.5}, {0.0, 0.5, 0.5}, {0.0, 0.0, 0.5},
+  {0.0, 0.0, 0.0}, {0.0, 0.0, 0.5}, {0.5, 0.0, 0.0}, {0.5, 0.0, 0.5},
+  {0.5, 0.5, 0.0}, {0.5, 0.5, 0.5}, {0.0, 0.5, 0.0}, {0.0, 0.5, 0.5}
+};
+static const float yee_e[][3] = { // yellow: e-field components
+  {0.45, 0.0, 0.0}, {0.55, 0.0, 0.0},
+  {0.0, 0.45, 0.0}, {0.0, 0.55, 0.0},
+  {0.0, 0.0, 0.45}, {0.0, 0.0, 0.55}
+};
+static const float yee_h[][3] = { // cyan: h-field components
+  {-0.05, 0.5, 0.5}, {0.05, 0.5, 0.5},
+  {0.5, -0.05, 0.5}, {0.5, 0.05, 0.5},
+  {0.5, 0.5, -0.05}, {0.5, 0.5, 0.05}
+};
+#define YEE_LINE_VERTICES (24 + 6 + 6)
+#define YEE_POINT_VERTICES (3 + 3)
+
+static unsigned char ubyte(double c) {return (unsigned char)(255.0 * c + 0.5);}
+
+CYeeLattice::CYeeLattice(size_t x, size_t y, size_t z) : vbuf(QGLBuffer::VertexBuffer)
+{
+  sx = x;
+  sy = y;
+  sz = z;
+  key = -1;
+  cells = lines = 0;
+  gl = vbo = moved = false;
+}
+
+CYeeLattice::~CYeeLattice()
+{
+  if(vbo) vbuf.destroy();
+}
+
+void CYeeLattice::build(size_t i0, size_t i1, size_t j0, size_t j1, size_t k0, size_t k1, size_t stride)
+{
+  if(stride < 1) stride = 1;
+  for(;; stride++) { // thin to budget
+    cells = ((i1 - i0) / stride + 1) * ((j1 - j0) / stride + 1) * ((k1 - k0) / stride + 1);
+    if(cells <= YEE_BUDGET) break;
+  }
+  double grey[4] = {MIDGREY, 0.5};
+  double yellow[4] = {MIDYELLOW, 1.0};
+  double cyan[4] = {MIDCYAN, 1.0};
+  const double *color[3] = {grey, yellow, cyan};
+  const float (*glyph[3])[3] = {yee_lines, yee_e, yee_h};
+  const int size[3] = {24, 6, 6};
+
+  vertex.resize(cells * (YEE_LINE_VERTICES + YEE_POINT_VERTICES));
+  lines = cells * YEE_LINE_VERTICES;
+  size_t l = 0;     // line vertex
+  size_t p = lines; // point vertex
+  for(size_t k = k0; k <= k1; k += stride) {
+    for(size_t j = j0; j <= j1; j += stride) {
+      for(size_t i = i0; i <= i1; i += stride) {
+        for(int g = 0; g < 3; g++) {
+          unsigned char c[4] = {ubyte(color[g][0]), ubyte(color[g][1]), ubyte(color[g][2]), ubyte(color[g][3])};
+          for(int v = 0; v < size[g]; v++) {
+            CVertex *w = &vertex[l++];
+            w->x = (i - sx / 2.0 + glyph[g][v][0]) / sx; // as glScale(1/s), glTranslate(i - s/2)
+            w->y = (j - sy / 2.0 + glyph[g][v][1]) / sy;
+            w->z = (k - sz / 2.0 + glyph[g][v][2]) / sz;
+            memcpy(w->c, c, 4);
+            if((g > 0) && ((v & 1) == 0)) vertex[p++] = *w; // component position
+          }
+        }
+      }
+    }
+  }
+  moved = true;
+}
+
+void CYeeLattice::draw()
+{
+  if(!gl) {
+    gl = true;
+    vbo = vbuf.create();
+    if(vbo) vbuf.setUsagePattern(QGLBuffer::StaticDraw);
+  }
+  if(vertex.empty()) return;
+  if(moved && vbo) {
+    vbuf.bind();
+    vbuf.allocate(&vertex[0], vertex.size() * sizeof(CVertex));
+    vbuf.release();
+  }
+  moved = false;
+
+  glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_POINT_BIT);
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+  glLineWidth(2.0);
+  glPointSize(6.0);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  const char *base = vbo ? 0 : (const char *)&vertex[0];
+  if(vbo) vbuf.bind();
+  glVertexPointer(3, GL_FLOAT, sizeof(CVertex), base);
+  glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(CVertex), base + 3 * sizeof(float));
+  glDrawArrays(GL_LINES, 0, lines);
+  glDrawArrays(GL_POINTS, lines, vertex.size() - lines);
+  if(vbo) vbuf.release();
+  glPopClientAttrib();
+  glPopAttrib();
+}
@@ -0,0 +1,59 @@
+/*
+GL_10
+An OpenGL+Qt4 FDTD electromagnetic simulation & visualization program.
+
+Copyright (C) 2005-2012 John Rugis
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+rugis@msu.edu
+*/
+
+#ifndef YEELATTICE_H
+#define YEELATTICE_H
+
+#include <QtOpenGL>
+#include <QGLBuffer>
+#include <vector>
+#include <stdlib.h>
+
+// Yee cell overlay (3D display): cell edges & field component positions for
+// a region of lattice points, baked into one vertex buffer (lines then points)
+// no OpenGL calls before the first draw(), the owner build()s when its key changes
+class CYeeLattice
+{
+public:
+  CYeeLattice(size_t sx, size_t sy, size_t sz);
+  ~CYeeLattice();
+
+  int key;      // lattice state (owner defined, -1 = none)
+  size_t cells; // cells in the last build
+
+  // lattice points i0..i1 (inclusive) etc., every stride (thinned to budget)
+  void build(size_t i0, size_t i1, size_t j0, size_t j1, size_t k0, size_t k1, size_t stride);
+  void draw();
+
+private:
+  struct CVertex {
+    float x, y, z;
+    unsigned char c[4];
+  };
+  size_t sx, sy, sz;
+  std::vector<CVertex> vertex; // line vertices then point vertices
+  size_t lines;                // line vertex count
+  bool gl, vbo, moved;
+  QGLBuffer vbuf;
+};
+
+#endif // YEELATTICE_H